@@ -0,0 +1,191 @@
+/************************************************************
+ * Closure.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Closure.h
+ ************************************************************/
+#include <stdlib.h>
+#include <stdint.h>
+#include "Closure.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define CLOSURE_X86 1
+#endif
+
+#define SIZE_BITS 31 // the number of bits a component size can have
+
+/**
+ * ClosureObj struct that holds the bitset of every SCC, stride words apart
+ */
+struct ClosureObj {
+  int numComponents;
+  size_t stride; // the number of 64-bit words in each bitset, a multiple of 4 so AVX2 never runs over
+  uint64_t* rows; // the bitsets, one after another
+  int* counts; // the number of vertices each SCC can reach
+};
+
+/**
+ * orWordsScalar method that ORs the n words of src into dst, 64 bits at a time
+ */
+static void orWordsScalar(uint64_t* dst, const uint64_t* src, size_t n) {
+  for (size_t i = 0; i < n; i++) {
+    dst[i] |= src[i];
+  }
+}
+
+/**
+ * countWordsScalar method that returns the number of bits set in both the n words of row and of mask
+ */
+static long long countWordsScalar(const uint64_t* row, const uint64_t* mask, size_t n) {
+  long long count = 0;
+  for (size_t i = 0; i < n; i++) {
+    count += __builtin_popcountll(row[i] & mask[i]);
+  }
+  return count;
+}
+
+#ifdef CLOSURE_X86
+/**
+ * orWordsSSE2 method that ORs the n words of src into dst, 128 bits at a time. n is a multiple of 4
+ */
+static void orWordsSSE2(uint64_t* dst, const uint64_t* src, size_t n) {
+  for (size_t i = 0; i < n; i += 2) {
+    __m128i a = _mm_loadu_si128((const __m128i*) (dst + i));
+    __m128i b = _mm_loadu_si128((const __m128i*) (src + i));
+    _mm_storeu_si128((__m128i*) (dst + i), _mm_or_si128(a, b));
+  }
+}
+
+/**
+ * orWordsAVX2 method that ORs the n words of src into dst, 256 bits at a time. n is a multiple of 4
+ */
+__attribute__((target("avx2")))
+static void orWordsAVX2(uint64_t* dst, const uint64_t* src, size_t n) {
+  for (size_t i = 0; i < n; i += 4) {
+    __m256i a = _mm256_loadu_si256((const __m256i*) (dst + i));
+    __m256i b = _mm256_loadu_si256((const __m256i*) (src + i));
+    _mm256_storeu_si256((__m256i*) (dst + i), _mm256_or_si256(a, b));
+  }
+}
+
+/**
+ * countWordsPopcnt method that is countWordsScalar compiled to use the POPCNT instruction
+ */
+__attribute__((target("popcnt")))
+static long long countWordsPopcnt(const uint64_t* row, const uint64_t* mask, size_t n) {
+  long long count = 0;
+  for (size_t i = 0; i < n; i++) {
+    count += __builtin_popcountll(row[i] & mask[i]);
+  }
+  return count;
+}
+#endif
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newClosure method that returns the transitive closure of the condensation C. The bitset of SCC r starts
+ * with just bit r, and the bitset of each successor t is ORed into it from word t / 64 on, since t's
+ * bitset has nothing before bit t. The number of vertices each SCC reaches is then counted with one mask
+ * per bit of the SCC sizes: mask k holds the SCCs whose size has bit k set, so the count is the sum of
+ * 2^k times the bits the bitset has in common with mask k. Only the masks some size uses are counted,
+ * which is just mask 0 when every SCC is a single vertex
+ *
+ * @param - C - the Condensation
+ * @return - the new Closure
+ */
+Closure newClosure(Condensation C) {
+  void (*orWords)(uint64_t*, const uint64_t*, size_t) = orWordsScalar;
+  long long (*countWords)(const uint64_t*, const uint64_t*, size_t) = countWordsScalar;
+#ifdef CLOSURE_X86
+  __builtin_cpu_init();
+  orWords = __builtin_cpu_supports("avx2") ? orWordsAVX2 : orWordsSSE2;
+  if (__builtin_cpu_supports("popcnt")) {
+    countWords = countWordsPopcnt;
+  }
+#endif
+
+  int n = C->numComponents;
+  Closure T = malloc(sizeof(struct ClosureObj));
+  T->numComponents = n;
+  T->stride = ((size_t) (n + 63) / 64 + 3) / 4 * 4;
+  T->rows = calloc(T->stride * n + 1, sizeof(uint64_t));
+  T->counts = malloc(sizeof(int) * (n + 1));
+
+  for (int r = n - 1; r >= 0; r--) {
+    uint64_t* row = T->rows + T->stride * r;
+    row[r / 64] |= 1ULL << (r % 64);
+    for (size_t e = C->offsets[r]; e < C->offsets[r + 1]; e++) {
+      int t = C->targets[e];
+      size_t from = (size_t) t / 256 * 4; // a multiple of 4 at or before word t / 64
+      orWords(row + from, T->rows + T->stride * t + from, T->stride - from);
+    }
+  }
+
+  uint64_t* masks[SIZE_BITS] = { NULL };
+  for (int r = 0; r < n; r++) {
+    for (int k = 0; k < SIZE_BITS; k++) {
+      if (C->componentSizes[r] & (1 << k)) {
+        if (masks[k] == NULL) {
+          masks[k] = calloc(T->stride, sizeof(uint64_t));
+        }
+        masks[k][r / 64] |= 1ULL << (r % 64);
+      }
+    }
+  }
+  for (int r = 0; r < n; r++) {
+    const uint64_t* row = T->rows + T->stride * r;
+    size_t from = (size_t) r / 64;
+    long long count = 0;
+    for (int k = 0; k < SIZE_BITS; k++) {
+      if (masks[k] != NULL) {
+        count += countWords(row + from, masks[k] + from, T->stride - from) << k;
+      }
+    }
+    T->counts[r] = (int) count;
+  }
+  for (int k = 0; k < SIZE_BITS; k++) {
+    free(masks[k]);
+  }
+  return T;
+}
+
+/**
+ * freeClosure method that frees the heap memory used by the Closure
+ *
+ * @param - pT - the pointer to the Closure
+ */
+void freeClosure(Closure* pT) {
+  Closure T = *pT;
+  free(T->rows);
+  free(T->counts);
+  free(T);
+  *pT = NULL;
+}
+
+/*** Access functions ***/
+
+/**
+ * closureBytes method that returns the memory a Closure of numComponents SCCs uses
+ *
+ * @param - numComponents - the number of SCCs
+ * @return - the number of bytes
+ */
+size_t closureBytes(int numComponents) {
+  size_t stride = ((size_t) (numComponents + 63) / 64 + 3) / 4 * 4;
+  return sizeof(uint64_t) * stride * numComponents + sizeof(int) * numComponents + sizeof(struct ClosureObj);
+}
+
+/**
+ * closureReaches method that returns whether SCC a can reach SCC b
+ */
+bool closureReaches(Closure T, int a, int b) {
+  return (T->rows[T->stride * a + b / 64] >> (b % 64)) & 1;
+}
+
+/**
+ * closureReachCount method that returns the number of vertices SCC a can reach
+ */
+int closureReachCount(Closure T, int a) {
+  return T->counts[a];
+}
@@ -0,0 +1,37 @@
+/************************************************************
+ * Closure.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef CLOSURE_H
+#define CLOSURE_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include "Condensation.h"
+
+// The transitive closure of the condensation of a digraph: one bitset per SCC holding every SCC it
+// can reach (itself included). The SCCs are numbered in topological order, so the bitsets are
+// filled from the last SCC to the first, each one the OR of the bitsets of its successors, and SCC r
+// only ever reaches SCCs r and up. The ORs run 256 bits at a time with AVX2 when the CPU has it, 128
+// bits at a time with SSE2 on other x86-64 CPUs, and 64 bits at a time everywhere else.
+
+// private ClosureObj type
+typedef struct ClosureObj* Closure;
+
+// Constructors-Destructors ---------------------------------------------------
+Closure newClosure(Condensation C); // returns the Closure of C, built in O(numComponents *
+// (numComponents + numEdges) / 64) word operations
+
+void freeClosure(Closure* pT); // frees all heap memory associated with its Closure* argument,
+// and sets *pT to NULL
+
+
+// Access functions -----------------------------------------------------------
+size_t closureBytes(int numComponents); // Returns the memory a Closure of that many SCCs uses.
+
+bool closureReaches(Closure T, int a, int b); // Returns whether SCC a can reach SCC b, in O(1).
+
+int closureReachCount(Closure T, int a); // Returns the number of vertices (not SCCs) that SCC a
+// can reach, its own included, in O(1).
+
+#endif
@@ -0,0 +1,60 @@
+/************************************************************
+ * Condensation.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Condensation.h
+ ************************************************************/
+#include <stdlib.h>
+#include "Condensation.h"
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newCondensation method that returns an empty Condensation of a digraph with numVertices vertices.
+ * A digraph never has more SCCs than vertices, so the per-SCC arrays are sized for numVertices
+ *
+ * @param - numVertices - the number of vertices
+ * @return - the new Condensation
+ */
+Condensation newCondensation(int numVertices) {
+  Condensation C = malloc(sizeof(CondensationObj));
+  C->numVertices = numVertices;
+  C->numComponents = 0;
+  C->numEdges = 0;
+  C->componentIds = malloc(sizeof(int) * (numVertices + 1));
+  C->componentSizes = malloc(sizeof(int) * (numVertices + 1));
+  C->offsets = calloc(numVertices + 1, sizeof(size_t));
+  C->targets = NULL;
+  C->edgeCapacity = 0;
+  return C;
+}
+
+/**
+ * freeCondensation method that frees the heap memory used by the Condensation
+ *
+ * @param - pC - the pointer to the Condensation
+ */
+void freeCondensation(Condensation* pC) {
+  Condensation C = *pC;
+  free(C->componentIds);
+  free(C->componentSizes);
+  free(C->offsets);
+  free(C->targets);
+  free(C);
+  *pC = NULL;
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * reserveCondensationEdges method that makes room for numEdges edges, keeping the edges already there
+ *
+ * @param - C - the Condensation
+ * @param - numEdges - the number of edges
+ */
+void reserveCondensationEdges(Condensation C, size_t numEdges) {
+  if (numEdges > C->edgeCapacity) {
+    size_t capacity = numEdges + numEdges / 2;
+    C->targets = realloc(C->targets, sizeof(int) * (capacity + 1));
+    C->edgeCapacity = capacity;
+  }
+}
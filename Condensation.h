@@ -0,0 +1,41 @@
+/************************************************************
+ * Condensation.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef CONDENSATION_H
+#define CONDENSATION_H
+
+#include <stddef.h>
+
+// The condensation of a digraph: the DAG with one node per Strongly Connected Component and an edge
+// from one SCC to another whenever some edge of the digraph goes between them. The SCCs are numbered
+// 0 .. numComponents - 1 in a topological order, so every edge goes from a lower number to a higher
+// one and the number of an SCC is its topological rank. The edges out of SCC c are
+// targets[offsets[c] .. offsets[c + 1]), without duplicates and in ascending order. The fields are
+// read-only for users of a Condensation.
+typedef struct CondensationObj {
+  int numVertices; // the number of vertices of the digraph
+  int numComponents; // the number of SCCs
+  size_t numEdges; // the number of edges between SCCs
+  int* componentIds; // numVertices entries: the SCC of each vertex (0-based)
+  int* componentSizes; // numComponents entries: the number of vertices in each SCC
+  size_t* offsets; // numComponents + 1 entries
+  int* targets; // numEdges entries
+  size_t edgeCapacity; // the number of entries targets has room for
+} CondensationObj;
+
+typedef CondensationObj* Condensation;
+
+// Constructors-Destructors ---------------------------------------------------
+Condensation newCondensation(int numVertices); // returns an empty Condensation of a digraph with
+// numVertices vertices
+
+void freeCondensation(Condensation* pC); // frees all heap memory associated with its Condensation*
+// argument, and sets *pC to NULL
+
+
+// Manipulation procedures ----------------------------------------------------
+void reserveCondensationEdges(Condensation C, size_t numEdges); // Makes room for numEdges edges,
+// keeping the ones already in targets. The array is only reallocated when it needs to grow.
+
+#endif
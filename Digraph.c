@@ -3,29 +3,107 @@
  * Tyler Hoang
  * Contains the code for the functions and descriptions in Digraph.h
  ************************************************************/
+#define _POSIX_C_SOURCE 200809L // for mmap
+#include "Closure.h"
+#include "Condensation.h"
 #include "Digraph.h"
+#include "NeighborSet.h"
+#include "OrderList.h"
+#include "Packed.h"
+#include "ParallelSCC.h"
+#include "ReachIndex.h"
+#include "Snapshot.h"
+#include "Stats.h"
+#include "Workspace.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#define SCC_UPDATE_BUDGET 2 // insertSCCEdge may look at this many times V + E between two full SCC computations
+#define BINARY_MAGIC "DIGRAPH" // the first 8 bytes of a binary digraph file (with the NUL)
+#define BINARY_FORMAT_VERSION 1
+#define BINARY_UNHASHED_SCC_VERSION 2 // a checkpoint from before the labelling had a hash (its SCCs are found again)
+#define BINARY_SCC_VERSION 3 // a binary digraph file followed by its SCC labelling and its hash (written by writeCheckpoint)
+#define BINARY_BYTE_ORDER 0x01020304u // reads back differently on a machine with the other byte order
+
+/**
+ * BinaryHeader typedef struct that starts a binary digraph file. It is followed by the CSR arrays of the
+ * digraph's Snapshot: outOffsets (numVertices + 1 uint64s), outTargets (numEdges int32s), padding up
+ * to a multiple of 8 bytes, inOffsets (numVertices + 1 uint64s) and inTargets (numEdges int32s), all
+ * in the byte order of the machine that wrote the file. In a BINARY_SCC_VERSION file they are followed
+ * by the SCC labelling, as int32s: numSCCs, numFree, the SCC indices in topological order, the size of
+ * each of those SCCs, the vertices of each of them in the order of their lists, and the numFree unused
+ * indices in the order of the freeComponents stack, then the FNV-1a hash of the labelling as a uint32
+ */
+typedef struct BinaryHeader {
+  char magic[8]; // BINARY_MAGIC
+  uint32_t formatVersion; // BINARY_FORMAT_VERSION
+  uint32_t byteOrder; // BINARY_BYTE_ORDER
+  int32_t numVertices;
+  uint32_t reserved; // 0
+  uint64_t numEdges;
+} BinaryHeader;
+
+/**
+ * BinaryLayout typedef struct that holds where each array of a binary digraph file starts
+ */
+typedef struct BinaryLayout {
+  size_t outOffsets;
+  size_t outTargets;
+  size_t inOffsets;
+  size_t inTargets;
+  size_t scc; // where the SCC labelling starts, if there is one
+  size_t size; // the size of the whole file without the SCC labelling
+} BinaryLayout;
 
 /**
  * DigraphObj typedef struct that is used to construct a Digraph object
  */
 typedef struct DigraphObj {
   int numVertices; // keeps track of the number of vertices in the Digraph
-  int numEdges; // keeps track of the number of edges in the Digraph
+  long long numEdges; // keeps track of the number of edges in the Digraph (64-bit, it can pass 2^31)
   int numSCCs; // keeps track of the number of SCCs in the Digraph
-  List* adjLists; // keeps track of each vertex's neighbors
-  int* markers; // used to mark the vertices
-  int* times; // used to keep track of the starting time of each vertex
-  int* finishTimes; // used to keep track of the finishing time of each vertex
-  int largestFinishTime; // keeps track of the largest finish time (to know which vertex to start DFS from after reversal)
-  int lowestFinishTime; // keeps track of the lowest finish time
-  int SCCVertices; // keeps track of the number of vertices in an SCC
-  List currentSCCList; // used as the current List of vertices in an SCC
-  List* SCCLists; // keeps track of all the SCCs in the Digraph and their respective vertices
+  NeighborSetObj* adjSets; // keeps track of each vertex's neighbors
+  NeighborSetObj* inSets; // keeps track of each vertex's incoming neighbors (the adjSets of G with its edges reversed)
+  int* componentIds; // caches the index of the SCC that each vertex belongs to (NULL until the first SCC computation)
+  int* componentSizes; // caches the number of vertices in each SCC
+  int* componentHeads; // the first vertex of each SCC (-1 if the index isn't in use)
+  int* componentTails; // the last vertex of each SCC
+  int* nextInComponent; // the vertex after each vertex in its SCC (-1 for the last one)
+  long version; // incremented every time the edge set changes
+  long sccVersion; // the version the cached SCC results were computed at (-1 if never computed)
+  long long sccUpdateBudget; // the vertices and edges insertSCCEdge may still look at before the cache is dropped
+  OrderList componentOrder; // a topological order of the SCCs (NULL until the first computation)
+  int* freeComponents; // a stack of the SCC indices that aren't in use
+  int numFreeComponents; // the number of indices on freeComponents
+  void* mapping; // the memory-mapped binary file the Digraph was loaded from (NULL if none)
+  size_t mappingSize; // the size of mapping
+  Snapshot snapshot; // the CSR copy of the edges that the SCC search runs on (NULL until the first freeze)
+  long snapshotVersion; // the version snapshot was built at
+  int sccThreads; // the number of threads getCountSCC uses (1 means the sequential algorithm)
+  SCCEngine sccEngine; // the parallel engine's threads and arrays (NULL until the first parallel computation)
+  int* topoRanks; // the position of each SCC in componentOrder (NULL until getTopoRank needs it)
+  long rankVersion; // the version topoRanks was computed at
+  Condensation condensation; // the condensation DAG (NULL until the first condenseDigraph)
+  long condensationVersion; // the version condensation was built at
+  ReachIndex reachIndex; // the reachability labels of the condensation (NULL until the first canReach)
+  long reachVersion; // the version reachIndex was built at
+  Closure closure; // the transitive closure of the condensation (NULL unless one was built)
+  long closureVersion; // the version closure was built at
+  size_t closureLimit; // the most memory closure may use (0 means it is never built)
+  Packed packed; // the compressed edges while G is packed, in place of adjSets and inSets (NULL otherwise)
+  int* unpacked; // room for the neighbors of one vertex decoded from packed
+  Workspace workspace; // the scratch arrays of G's searches (NULL until the first search)
 } DigraphObj;
 
+
 /*** Constructors-Destructors ***/
 
 /**
@@ -39,37 +117,134 @@ Digraph newDigraph(int numVertices) {
   g->numVertices = numVertices; // set numVertices
   g->numEdges = 0; // initialize numEdges
   g->numSCCs = 0; // initialize numSCCs
-  g->largestFinishTime = -1; // initialize largestFinishTime
-  g->lowestFinishTime = 999999; // initialize lowestFinishTime to be some arbitrary large number
-  g-> SCCVertices = 0;
+  g->version = 0; // initialize version
+  g->sccVersion = -1; // no SCC results have been cached yet
+  g->sccUpdateBudget = 0;
+  g->componentOrder = NULL; // made by the first SCC computation
+  g->componentIds = NULL; // made by the first SCC computation
+  g->componentSizes = NULL;
+  g->componentHeads = NULL;
+  g->componentTails = NULL;
+  g->nextInComponent = NULL;
+  g->freeComponents = NULL; // made by the first SCC computation
+  g->numFreeComponents = 0;
+  g->mapping = NULL; // not loaded from a binary file
+  g->mappingSize = 0;
+  g->snapshot = NULL; // built by the first freezeDigraph
+  g->snapshotVersion = -1;
+  g->sccThreads = 1; // the sequential algorithm unless setSCCThreads says otherwise
+  g->sccEngine = NULL; // started by the first parallel computation
+  g->topoRanks = NULL; // made by the first getTopoRank or condenseDigraph
+  g->rankVersion = -1;
+  g->condensation = NULL; // built by the first condenseDigraph
+  g->condensationVersion = -1;
+  g->reachIndex = NULL; // built by the first canReach
+  g->reachVersion = -1;
+  g->closure = NULL; // built by the first query that can use it
+  g->closureVersion = -1;
+  g->closureLimit = 0; // no closure unless setClosureLimit allows one
+  g->packed = NULL; // the edges live in adjSets and inSets until packDigraph
+  g->unpacked = NULL;
+  g->workspace = NULL; // made by the first search
 
-  g->adjLists = malloc(sizeof(List) * numVertices); // allocate a List array structure from heap memory
+  g->adjSets = malloc(sizeof(NeighborSetObj) * numVertices); // allocate a NeighborSet array structure from heap memory
+  g->inSets = malloc(sizeof(NeighborSetObj) * numVertices); // allocate a NeighborSet array structure from heap memory
   for (int i = 0; i < numVertices; i++) {
-    g->adjLists[i] = newList(); // create a new List for each element of adjLists
+    initNeighborSet(&g->adjSets[i]); // every vertex starts with no neighbors
+    initNeighborSet(&g->inSets[i]); // and no incoming neighbors
   }
 
-  g->SCCLists = malloc(sizeof(List) * numVertices); // allocate a List array structure from heap memory
-  for (int i = 0; i < numVertices; i++) {
-    g->SCCLists[i] = newList(); // create a new List for each element of SCCLists
-  }
+  return g;
+}
 
-  g->markers = malloc(sizeof(int) * numVertices); // allocate an int array structure from heap memory
-  for (int i = 0; i < numVertices; i++) {
-    g->markers[i] = UNVISITED; //initialize each element as unvisited
+/**
+ * countingSortPairs method that stably sorts the pairs (keys[i], vals[i]) by key with a counting sort
+ *
+ * @param - keys - the keys, each in [0, n)
+ * @param - vals - the values that go with the keys
+ * @param - m - the number of pairs
+ * @param - n - the number of distinct keys
+ * @param - sortedKeys - where the sorted keys are written
+ * @param - sortedVals - where the values are written in the same order
+ * @param - offsets - n + 1 entries; on return the pairs with key k are at [offsets[k], offsets[k + 1])
+ */
+static void countingSortPairs(const int* keys, const int* vals, size_t m, int n, int* sortedKeys, int* sortedVals, size_t* offsets) {
+  for (int k = 0; k <= n; k++) {
+    offsets[k] = 0;
   }
+  for (size_t i = 0; i < m; i++) { // count the pairs with each key
+    offsets[keys[i] + 1]++;
+  }
+  for (int k = 0; k < n; k++) { // turn the counts into starting positions
+    offsets[k + 1] += offsets[k];
+  }
+  for (size_t i = 0; i < m; i++) { // place each pair after the earlier pairs with the same key
+    size_t at = offsets[keys[i]]++;
+    sortedKeys[at] = keys[i];
+    sortedVals[at] = vals[i];
+  }
+  for (int k = n; k > 0; k--) { // placing advanced every start to the next key's start, so shift them back
+    offsets[k] = offsets[k - 1];
+  }
+  offsets[0] = 0;
+}
 
-  g->times = malloc(sizeof(int) * numVertices); // allocate an int array structure from heap memory
-  for (int i = 0; i < numVertices; i++) {
-    g->times[i] = 0; //initialize each element to 0
+/**
+ * newDigraphFromEdges method that returns a Digraph with numVertices vertices and the edges (us[i], vs[i]).
+ * The edges are sorted by (u, v) with two counting sort passes, duplicates are dropped, and every vertex's
+ * neighbors are laid out in one step, so building costs O(numVertices + m) instead of one addEdge per edge.
+ * Edges that addEdge would reject as illegal are skipped
+ *
+ * @param - numVertices - the number of vertices to be in the Digraph
+ * @param - us - the starting vertex of each edge
+ * @param - vs - the ending vertex of each edge
+ * @param - m - the number of edges
+ * @return - the new Digraph
+ */
+Digraph newDigraphFromEdges(int numVertices, const int* us, const int* vs, size_t m) {
+  Digraph g = newDigraph(numVertices);
+  int* a = malloc(sizeof(int) * (m + 1)); // the starting vertices of the legal edges (0-based)
+  int* b = malloc(sizeof(int) * (m + 1)); // the ending vertices of the legal edges (0-based)
+  int* sortedA = malloc(sizeof(int) * (m + 1));
+  int* sortedB = malloc(sizeof(int) * (m + 1));
+  size_t* offsets = malloc(sizeof(size_t) * (numVertices + 1));
+
+  size_t legal = 0;
+  for (size_t i = 0; i < m; i++) { // keep only the legal edges
+    if (us[i] >= 1 && vs[i] >= 1 && us[i] <= numVertices && vs[i] <= numVertices) {
+      a[legal] = us[i] - 1;
+      b[legal] = vs[i] - 1;
+      legal++;
+    }
   }
 
-  g->currentSCCList = newList(); // initialize currentSCCList to be used when creating the array of SCCLists
+  countingSortPairs(b, a, legal, numVertices, sortedB, sortedA, offsets); // sort by v first
+  countingSortPairs(sortedA, sortedB, legal, numVertices, a, b, offsets); // then stably by u, giving (u, v) order
 
-  g->finishTimes = malloc(sizeof(int) * numVertices); // allocate an int array structure from heap memory
-  for (int i =0; i < numVertices; i++) {
-    g->finishTimes[i] = 0; // initialize each element as unvisited
+  size_t edges = 0;
+  for (int u = 0; u < numVertices; u++) { // drop duplicates and hand each vertex its sorted neighbors
+    size_t start = edges;
+    for (size_t i = offsets[u]; i < offsets[u + 1]; i++) {
+      if (i == offsets[u] || b[i] != b[i - 1]) {
+        a[edges] = u;
+        b[edges] = b[i];
+        edges++;
+      }
+    }
+    setSortedNeighbors(&g->adjSets[u], b + start, (int) (edges - start));
   }
 
+  countingSortPairs(b, a, edges, numVertices, sortedB, sortedA, offsets); // group by v, keeping u ascending
+  for (int v = 0; v < numVertices; v++) { // hand each vertex its sorted incoming neighbors
+    setSortedNeighbors(&g->inSets[v], sortedA + offsets[v], (int) (offsets[v + 1] - offsets[v]));
+  }
+  g->numEdges = (long long) edges;
+
+  free(a);
+  free(b);
+  free(sortedA);
+  free(sortedB);
+  free(offsets);
   return g;
 }
 
@@ -79,7 +254,13 @@ Digraph newDigraph(int numVertices) {
  * @param - pG - the pointer to the Diraph
  */
 void freeDigraph(Digraph* pG) {
-  clearDigraph(*pG); // clear every List in the Digraph first
+  clearDigraph(*pG); // clear every NeighborSet and cache in the Digraph first
+  if ((*pG)->workspace != NULL) {
+    freeWorkspace(&(*pG)->workspace); // free the scratch arrays of its searches
+  }
+  if ((*pG)->sccEngine != NULL) {
+    freeSCCEngine(&(*pG)->sccEngine); // stop the threads of the parallel engine
+  }
   free(*pG); // free the memory
   *pG = NULL;  // safely set the pointer to NULL
 }
@@ -90,28 +271,79 @@ void freeDigraph(Digraph* pG) {
  * @param - G - the Digraph
  */
 void clearDigraph(Digraph G) {
-  for (int i = 0; i < getOrder(G); i++) { // iterate through the adjLists array
-    List L = G->adjLists[i];
-    freeList(&L); // free each List
+  for (int i = 0; G->adjSets != NULL && i < getOrder(G); i++) { // iterate through the adjSets and inSets arrays (gone while packed)
+    freeNeighborSet(&G->adjSets[i]); // free each NeighborSet
+    freeNeighborSet(&G->inSets[i]);
   }
 
-  for (int i = 0; i < getOrder(G); i++) { // iterate through the SCCLists array
-    List L = G->SCCLists[i];
-    freeList(&L); // free each List
+  free(G->adjSets); // free the adjSets array
+  free(G->inSets); // free the inSets array
+  free(G->componentIds); // free the componentIds array
+  free(G->componentSizes); // free the componentSizes array
+  free(G->componentHeads); // free the lists of the vertices of each SCC
+  free(G->componentTails);
+  free(G->nextInComponent);
+  G->adjSets = NULL; // set the adjSets pointer to NULL
+  G->inSets = NULL; // set the inSets pointer to NULL
+  G->componentIds = NULL; // set the componentIds pointer to NULL
+  G->componentSizes = NULL; // set the componentSizes pointer to NULL
+  G->componentHeads = NULL;
+  G->componentTails = NULL;
+  G->nextInComponent = NULL;
+  if (G->snapshot != NULL) {
+    freeSnapshot(&G->snapshot); // free the CSR copy
+  }
+  if (G->componentOrder != NULL) {
+    freeOrderList(&G->componentOrder); // free the topological order of the SCCs
+  }
+  free(G->freeComponents);
+  G->freeComponents = NULL;
+  G->snapshotVersion = -1;
+  if (G->condensation != NULL) {
+    freeCondensation(&G->condensation); // free the condensation DAG
+  }
+  free(G->topoRanks);
+  G->topoRanks = NULL;
+  G->rankVersion = -1;
+  G->condensationVersion = -1;
+  if (G->reachIndex != NULL) {
+    freeReachIndex(&G->reachIndex); // free the reachability labels
+  }
+  G->reachVersion = -1;
+  if (G->closure != NULL) {
+    freeClosure(&G->closure); // free the transitive closure
   }
+  G->closureVersion = -1;
+  if (G->packed != NULL) {
+    freePacked(&G->packed); // free the compressed edges
+  }
+  free(G->unpacked);
+  G->unpacked = NULL;
+  if (G->mapping != NULL) { // the sets and the snapshot no longer point into the file, so unmap it
+    munmap(G->mapping, G->mappingSize);
+    G->mapping = NULL;
+  }
+  G->sccVersion = -1; // the cached SCC results are gone
+}
 
-  List K = G->currentSCCList;
-  freeList(&K); // free the currentSCCList List
-  free(G->adjLists); // free the adjLists array
-  free(G->SCCLists); // free the SCCLists array
-  free(G->markers); // free the markers array
-  free(G->times); // free the times array
-  free(G->finishTimes); // free the finishTimes array
-  G->adjLists = NULL; // set the adjLists pointer to NULL
-  G->SCCLists = NULL; // set the SCCLists pointer to NULL
-  G->markers = NULL; // set the markers pointer to NULL
-  G->times = NULL; // set the times pointer to NULL
-  G->finishTimes = NULL; // set the finishTimes pointer to NULL
+/**
+ * neighborsOf method that returns the outgoing or incoming neighbors of vertex x in ascending order, from its
+ * NeighborSet or decoded from packed into unpacked
+ *
+ * @param - G - the Digraph
+ * @param - x - the vertex (0-based)
+ * @param - forward - true for the outgoing neighbors, false for the incoming ones
+ * @param - degree - where the number of neighbors is stored
+ * @return - the neighbors, valid until the next change to G or the next call on a packed G
+ */
+static const int* neighborsOf(Digraph G, int x, bool forward, int* degree) {
+  if (G->packed != NULL) {
+    *degree = unpackNeighbors(G->packed, forward, x, G->unpacked);
+    return G->unpacked;
+  }
+  NeighborSet S = forward ? &G->adjSets[x] : &G->inSets[x];
+  *degree = neighborCount(S);
+  return sortedNeighbors(S);
 }
 
 /*** Access functions ***/
@@ -132,7 +364,7 @@ int getOrder(Digraph G) {
  * @param - G - the Digraph
  * @return - numEdges
  */
-int getSize(Digraph G) {
+long long getSize(Digraph G) {
   return G->numEdges;
 }
 
@@ -144,22 +376,286 @@ int getSize(Digraph G) {
  * @return - the number of neighbors
  */
 int getOutDegree(Digraph G, int u) {
-  return length(G->adjLists[u - 1]);
+  if (G->packed != NULL) {
+    return packedDegree(G->packed, true, u - 1);
+  }
+  return neighborCount(&G->adjSets[u - 1]);
 }
 
 /**
- * getNeighbors method that returns the List of neighbors of vertex u in G
+ * getInDegree method that returns the number of incoming neighbors that vertex u has in G
  *
  * @param - G - the Digraph
  * @param - u - the vertex
- * @return - the neighbor List
+ * @return - the number of incoming neighbors
  */
-List getNeighbors(Digraph G, int u) {
-  return G->adjLists[u - 1];
+int getInDegree(Digraph G, int u) {
+  if (G->packed != NULL) {
+    return packedDegree(G->packed, false, u - 1);
+  }
+  return neighborCount(&G->inSets[u - 1]);
+}
+
+/**
+ * getNeighbors method that returns the neighbors of vertex u in G in ascending order
+ *
+ * @param - G - the Digraph
+ * @param - u - the vertex
+ * @return - an array of getOutDegree(G, u) neighbors (0-based)
+ */
+const int* getNeighbors(Digraph G, int u) {
+  int degree;
+  return neighborsOf(G, u - 1, true, &degree);
 }
 
 /*** Manipulation procedures ***/
 
+/**
+ * packDigraph method that compresses the edges of G into a Packed and frees the NeighborSets, so G takes a
+ * fraction of the memory while it is only read. Each set is freed as soon as it is packed, so G never
+ * holds both copies of an edge list, and then the arrays of sets are freed too. The snapshot is freed as
+ * well, and so is the binary file G was mapped from, since nothing points into it anymore
+ *
+ * @param - G - the Digraph
+ */
+void packDigraph(Digraph G) {
+  if (G->packed != NULL) {
+    return;
+  }
+  Packed P = newPacked(G->numVertices);
+  for (int i = 0; i < G->numVertices; i++) {
+    packNeighbors(P, true, sortedNeighbors(&G->adjSets[i]), neighborCount(&G->adjSets[i]));
+    freeNeighborSet(&G->adjSets[i]);
+  }
+  for (int i = 0; i < G->numVertices; i++) {
+    packNeighbors(P, false, sortedNeighbors(&G->inSets[i]), neighborCount(&G->inSets[i]));
+    freeNeighborSet(&G->inSets[i]);
+  }
+  finishPacked(P);
+  free(G->adjSets); // every set is empty now, so the arrays of them can go too
+  free(G->inSets);
+  G->adjSets = NULL;
+  G->inSets = NULL;
+  G->packed = P;
+  G->unpacked = malloc(sizeof(int) * (maxPackedDegree(P) + 1));
+  if (G->snapshot != NULL) {
+    freeSnapshot(&G->snapshot);
+    G->snapshotVersion = -1;
+  }
+  if (G->mapping != NULL) {
+    munmap(G->mapping, G->mappingSize);
+    G->mapping = NULL;
+  }
+}
+
+/**
+ * unpackDigraph method that decodes packed back into the NeighborSets so G can be changed again
+ *
+ * @param - G - the Digraph
+ */
+static void unpackDigraph(Digraph G) {
+  G->adjSets = malloc(sizeof(NeighborSetObj) * G->numVertices);
+  G->inSets = malloc(sizeof(NeighborSetObj) * G->numVertices);
+  for (int i = 0; i < G->numVertices; i++) {
+    initNeighborSet(&G->adjSets[i]);
+    initNeighborSet(&G->inSets[i]);
+    int degree = unpackNeighbors(G->packed, true, i, G->unpacked);
+    setSortedNeighbors(&G->adjSets[i], G->unpacked, degree);
+    degree = unpackNeighbors(G->packed, false, i, G->unpacked);
+    setSortedNeighbors(&G->inSets[i], G->unpacked, degree);
+  }
+  freePacked(&G->packed);
+  free(G->unpacked);
+  G->unpacked = NULL;
+}
+
+/**
+ * useWorkspace method that returns G's Workspace with room for its vertices, making it on the first search
+ *
+ * @param - G - the Digraph
+ * @return - the Workspace
+ */
+static Workspace useWorkspace(Digraph G) {
+  if (G->workspace == NULL) {
+    G->workspace = newWorkspace();
+  }
+  reserveWorkspace(G->workspace, G->numVertices);
+  return G->workspace;
+}
+
+/**
+ * appendMember method that adds vertex x to the end of the list of the vertices of SCC c
+ *
+ * @param - G - the Digraph
+ * @param - c - the SCC
+ * @param - x - the vertex (0-based)
+ */
+static void appendMember(Digraph G, int c, int x) {
+  G->nextInComponent[x] = -1;
+  if (G->componentHeads[c] < 0) {
+    G->componentHeads[c] = x;
+  }
+  else {
+    G->nextInComponent[G->componentTails[c]] = x;
+  }
+  G->componentTails[c] = x;
+}
+
+/**
+ * searchSCCs method that finds every SCC that can be reached from SCC start (forward, along adjSets) or
+ * that can reach it (backward, along inSets) without leaving the SCCs whose keys in componentOrder are
+ * between low and high. The SCCs found are marked with the Workspace's stamp in marks and stored in found.
+ * Every vertex and edge looked at is taken from sccUpdateBudget, and the search gives up once it runs out
+ *
+ * @param - G - the Digraph
+ * @param - start - the SCC to start from
+ * @param - forward - whether to follow the edges forward
+ * @param - low - the smallest key to enter
+ * @param - high - the largest key to enter
+ * @param - marks - the Workspace's forwardStamps or backwardStamps
+ * @param - found - where the SCCs found are stored
+ * @return - the number of SCCs found, or -1 if the budget ran out
+ */
+static int searchSCCs(Digraph G, int start, bool forward, long long low, long long high, int* marks, int* found) {
+  int count = 0;
+  int top = 0;
+  long long visited = 0; // for the stats
+  long long scanned = 0;
+  Workspace W = G->workspace;
+  marks[start] = W->stamp;
+  W->componentStack[top++] = start;
+  while (top > 0) {
+    int c = W->componentStack[--top];
+    found[count++] = c;
+    for (int x = G->componentHeads[c]; x >= 0; x = G->nextInComponent[x]) { // every vertex of the SCC
+      NeighborSet S = forward ? &G->adjSets[x] : &G->inSets[x];
+      const int* neighbors = sortedNeighbors(S);
+      int degree = neighborCount(S);
+      visited++;
+      scanned += degree;
+      G->sccUpdateBudget -= 1 + degree;
+      if (G->sccUpdateBudget < 0) {
+        count = -1;
+        top = 0;
+        break;
+      }
+      for (int i = 0; i < degree; i++) {
+        int d = G->componentIds[neighbors[i]];
+        if (marks[d] == W->stamp) { // already found (this includes edges inside the SCC)
+          continue;
+        }
+        long long key = orderKey(G->componentOrder, d);
+        if (key >= low && key <= high) {
+          marks[d] = W->stamp;
+          W->componentStack[top++] = d;
+        }
+      }
+    }
+  }
+  COUNT_STAT(verticesVisited, visited);
+  COUNT_STAT(edgesScanned, scanned);
+  return count;
+}
+
+/**
+ * mergeInto method that moves every vertex of SCC c into SCC keep
+ *
+ * @param - G - the Digraph
+ * @param - keep - the SCC that grows
+ * @param - c - the SCC that disappears
+ */
+static void mergeInto(Digraph G, int keep, int c) {
+  for (int x = G->componentHeads[c]; x >= 0; x = G->nextInComponent[x]) {
+    G->componentIds[x] = keep;
+  }
+  G->nextInComponent[G->componentTails[keep]] = G->componentHeads[c]; // c's vertices go after keep's
+  G->componentTails[keep] = G->componentTails[c];
+  G->componentSizes[keep] += G->componentSizes[c];
+  G->componentSizes[c] = 0;
+  G->componentHeads[c] = -1;
+  unplace(G->componentOrder, c);
+  G->freeComponents[G->numFreeComponents++] = c; // c can be reused when an SCC splits
+  G->numSCCs--;
+}
+
+/**
+ * insertSCCEdge method that updates the cached SCC results after the edge (u, v) was added, with the
+ * Pearce-Kelly algorithm for keeping a topological order, run on the SCCs instead of the vertices.
+ * If u and v are in the same SCC, or u's SCC already comes before v's in componentOrder, nothing changes.
+ * Otherwise only the SCCs with keys between v's and u's are searched: F is what v's SCC can reach and B
+ * is what can reach u's SCC. If F contains u's SCC, the new edge closes a cycle and the SCCs in both F
+ * and B (M) merge into one. The SCCs of F and B are then reordered as B - M, M, F - M among the
+ * positions they already held, which puts every edge in order again. The searches share one budget of
+ * SCC_UPDATE_BUDGET times V + E between two full computations, so a run of AddEdges never costs more than
+ * a few recomputations; once it runs out nothing is changed and the caller drops the cache
+ *
+ * @param - G - the Digraph
+ * @param - u - the starting vertex of the new edge (0-based)
+ * @param - v - the ending vertex of the new edge (0-based)
+ * @return - false if the budget ran out
+ */
+static bool insertSCCEdge(Digraph G, int u, int v) {
+  int cu = G->componentIds[u];
+  int cv = G->componentIds[v];
+  if (cu == cv) {
+    return true; // an edge inside an SCC changes nothing
+  }
+  long long low = orderKey(G->componentOrder, cv);
+  long long high = orderKey(G->componentOrder, cu);
+  if (high < low) {
+    return true; // the edge already follows the order
+  }
+
+  Workspace W = useWorkspace(G);
+  int stamp = nextStamp(W);
+  int numForward = searchSCCs(G, cv, true, low, high, W->forwardStamps, W->forwardSCCs);
+  int numBackward = numForward < 0 ? -1 : searchSCCs(G, cu, false, low, high, W->backwardStamps, W->backwardSCCs);
+  if (numBackward < 0) {
+    return false; // nothing has been changed yet
+  }
+  bool cycle = W->forwardStamps[cu] == stamp;
+
+  int keep = -1; // the largest SCC in M, which the others merge into
+  if (cycle) {
+    for (int i = 0; i < numForward; i++) {
+      int c = W->forwardSCCs[i];
+      if (W->backwardStamps[c] == stamp && (keep < 0 || G->componentSizes[c] > G->componentSizes[keep])) {
+        keep = c;
+      }
+    }
+  }
+
+  int* sequence = W->componentStack; // the searches are done, so the stack can hold the new order
+  int length = 0;
+  sortPlaced(G->componentOrder, W->backwardSCCs, numBackward);
+  sortPlaced(G->componentOrder, W->forwardSCCs, numForward);
+  for (int i = 0; i < numBackward; i++) { // B - M, in its current order
+    int c = W->backwardSCCs[i];
+    if (W->forwardStamps[c] != stamp) {
+      sequence[length++] = c;
+    }
+  }
+  if (cycle) {
+    sequence[length++] = keep; // M
+  }
+  for (int i = 0; i < numForward; i++) { // F - M, in its current order
+    int c = W->forwardSCCs[i];
+    if (W->backwardStamps[c] != stamp) {
+      sequence[length++] = c;
+    }
+  }
+  if (cycle) {
+    for (int i = 0; i < numForward; i++) { // the rest of M merges into keep and gives up its position
+      int c = W->forwardSCCs[i];
+      if (c != keep && W->backwardStamps[c] == stamp) {
+        mergeInto(G, keep, c);
+      }
+    }
+  }
+  permuteOrder(G->componentOrder, sequence, length);
+  return true;
+}
+
 /**
  * addEdge method that adds an edge between two vertices in G, going from u to v
  *
@@ -175,48 +671,259 @@ int addEdge(Digraph G, int u, int v){
   if (u > G->numVertices || v > G->numVertices) { // if u or v are greater than numVertices
     return -1; // illegal
   }
+  if (G->packed != NULL) { // a packed digraph is read-only, so go back to the NeighborSets first
+    unpackDigraph(G);
+  }
 
-  bool exists = false; // used to see if the one vertex exists in the other vertex's List of neighbors
-  Node currentU = getFront(G->adjLists[u-1]); // set currentU to be the first Node in u's List of neighbors
+  if (!insertNeighbor(&G->adjSets[u - 1], v - 1)) { // if v is already in u's set of neighbors
+    return 1;
+  }
+  insertNeighbor(&G->inSets[v - 1], u - 1); // add u to v's set of incoming neighbors
+  G->numEdges++;
+  bool cached = G->sccVersion == G->version; // whether the SCC results were up to date before this edge
+  G->version++; // the edge set changed
+  if (cached) { // bring the cached SCC results up to date instead of recomputing them later
+    if (insertSCCEdge(G, u - 1, v - 1)) {
+      G->sccVersion = G->version;
+      COUNT_STAT(sccEdgeUpdates, 1);
+    }
+    else { // keeping them up to date has cost as much as recomputing them would
+      forgetSCCs(G);
+      COUNT_STAT(sccUpdateDrops, 1);
+    }
+  }
+  return 0;
+}
 
-  if (currentU == NULL) { // if u doesn't have a List of neighbors                                                   
-    G->numEdges++;
-    append(G->adjLists[u - 1], v - 1); // add v to the List                                                          
-    exists = true; // exists is set to true here so that the program will skip over the next if statement            
+/**
+ * expandLevel method that expands one level of a breadth first search inside SCC c, forward along adjSets
+ * or backward along inSets. Vertices reached by this search are marked with own, and reaching a vertex
+ * marked with other means the two searches met
+ *
+ * @param - G - the Digraph
+ * @param - queue - the search's queue; queue[*head .. *tail) is the current level
+ * @param - head - the start of the current level
+ * @param - tail - the end of the current level, moved to the end of the next one
+ * @param - forward - whether to follow the edges forward
+ * @param - c - the SCC to stay inside
+ * @param - own - the stamp of this search
+ * @param - other - the stamp of the search coming from the other side
+ * @return - true if the searches met
+ */
+static bool expandLevel(Digraph G, int* queue, int* head, int* tail, bool forward, int c, int own, int other) {
+  int end = *tail;
+  int start = *head;
+  long long scanned = 0; // for the stats
+  bool met = false;
+  int* stamps = G->workspace->vertexStamps;
+  while (*head < end && !met) {
+    int x = queue[(*head)++];
+    NeighborSet S = forward ? &G->adjSets[x] : &G->inSets[x];
+    const int* neighbors = sortedNeighbors(S);
+    int degree = neighborCount(S);
+    scanned += degree;
+    for (int i = 0; i < degree; i++) {
+      int y = neighbors[i];
+      if (G->componentIds[y] != c || stamps[y] == own) {
+        continue;
+      }
+      if (stamps[y] == other) {
+        met = true;
+        break;
+      }
+      stamps[y] = own;
+      queue[(*tail)++] = y;
+    }
   }
+  COUNT_STAT(verticesVisited, *head - start);
+  COUNT_STAT(edgesScanned, scanned);
+  return met;
+}
 
-  if (currentU != NULL && !exists) { // if u has a List of neighbors
-    while(currentU != NULL) { // traverse through the List
-      if (getValue(currentU) == v - 1) { // if v is already in u's List of neighbors
-	exists = true;
-	return 1;
-	break;
+/**
+ * reachesWithin method that returns whether u can still reach v using only edges inside SCC c. It
+ * searches forward from u and backward from v at the same time, always expanding the smaller frontier,
+ * and stops as soon as the two searches meet
+ *
+ * @param - G - the Digraph
+ * @param - u - the starting vertex (0-based)
+ * @param - v - the vertex to look for (0-based)
+ * @param - c - the SCC that u and v are in
+ * @return - true if v was found
+ */
+static bool reachesWithin(Digraph G, int u, int v, int c) {
+  int* forwardQueue = malloc(sizeof(int) * G->componentSizes[c]);
+  int* backwardQueue = malloc(sizeof(int) * G->componentSizes[c]);
+  int forwardHead = 0;
+  int forwardTail = 0;
+  int backwardHead = 0;
+  int backwardTail = 0;
+  Workspace W = useWorkspace(G);
+  int forwardStamp = nextStamp(W);
+  int backwardStamp = nextStamp(W);
+  W->vertexStamps[u] = forwardStamp;
+  W->vertexStamps[v] = backwardStamp;
+  forwardQueue[forwardTail++] = u;
+  backwardQueue[backwardTail++] = v;
+
+  bool found = false;
+  while (!found && forwardHead < forwardTail && backwardHead < backwardTail) { // until one side runs out
+    if (forwardTail - forwardHead <= backwardTail - backwardHead) {
+      found = expandLevel(G, forwardQueue, &forwardHead, &forwardTail, true, c, forwardStamp, backwardStamp);
+    }
+    else {
+      found = expandLevel(G, backwardQueue, &backwardHead, &backwardTail, false, c, backwardStamp, forwardStamp);
+    }
+  }
+  free(forwardQueue);
+  free(backwardQueue);
+  return found;
+}
+
+/**
+ * splitSCC method that finds the SCCs of the subgraph induced by the vertices of SCC c with an iterative
+ * version of Tarjan's algorithm, and replaces c with them. The largest part keeps the index c, the
+ * others get indices from freeComponents, and they take c's place in componentOrder in topological order
+ *
+ * @param - G - the Digraph
+ * @param - c - the SCC to split
+ */
+static void splitSCC(Digraph G, int c) {
+  int k = G->componentSizes[c];
+  int* low = malloc(sizeof(int) * k); // the Tarjan lowlink of each vertex, by discovery index
+  int* cursors = malloc(sizeof(int) * k); // the next neighbor to look at, by discovery index
+  bool* onStack = malloc(sizeof(bool) * k); // whether the vertex is on the Tarjan stack, by discovery index
+  int* path = malloc(sizeof(int) * k); // the DFS path
+  int* stack = malloc(sizeof(int) * k); // the Tarjan stack
+  int* parts = malloc(sizeof(int) * k); // the vertices, grouped by part as the parts are found
+  int* partEnds = malloc(sizeof(int) * (k + 1)); // parts[partEnds[p - 1] .. partEnds[p]) is part p
+  int numParts = 0;
+  int numPopped = 0;
+  int index = 0;
+  long long scanned = 0; // for the stats
+  Workspace W = useWorkspace(G);
+  int stamp = nextStamp(W); // vertexStamps[x] == stamp once x is discovered, and then marks[x] is its discovery index
+
+  for (int s = G->componentHeads[c]; s >= 0; s = G->nextInComponent[s]) {
+    if (W->vertexStamps[s] == stamp) {
+      continue;
+    }
+    int pathTop = 0;
+    int stackTop = 0;
+    W->vertexStamps[s] = stamp;
+    W->marks[s] = index;
+    low[index] = index;
+    cursors[index] = 0;
+    onStack[index] = true;
+    index++;
+    path[pathTop++] = s;
+    stack[stackTop++] = s;
+    while (pathTop > 0) {
+      int x = path[pathTop - 1];
+      int ix = W->marks[x];
+      if (cursors[ix] < neighborCount(&G->adjSets[x])) {
+        int y = sortedNeighbors(&G->adjSets[x])[cursors[ix]++];
+        if (G->componentIds[y] != c) {
+          continue; // outside the SCC being split
+        }
+        if (W->vertexStamps[y] != stamp) { // extend the DFS path to y
+          W->vertexStamps[y] = stamp;
+          W->marks[y] = index;
+          low[index] = index;
+          cursors[index] = 0;
+          onStack[index] = true;
+          index++;
+          path[pathTop++] = y;
+          stack[stackTop++] = y;
+        }
+        else if (onStack[W->marks[y]] && W->marks[y] < low[ix]) {
+          low[ix] = W->marks[y];
+        }
+        continue;
       }
-      currentU = getNextNode(currentU);;
-    }
-  }
-  
-  if(!exists) { // if this is a new edge being added and if u has a List of neighbors
-    Node traversal = getFront(G->adjLists[u - 1]);
-    // insert v into the neighor List in descending order (keeps the Lists sorted)
-    while (traversal != NULL) { // traverse through u's List of neighbors      
-      if (v-1 < getValue(traversal)) { // if v is less than the current neighbor in the traversal
-	G->numEdges++;
-	insertBefore(G->adjLists[u - 1], traversal, v - 1); // insert v before this value
-	break;
+      pathTop--; // x is done
+      scanned += neighborCount(&G->adjSets[x]);
+      if (low[ix] == ix) { // x is the root of a part: pop it off the Tarjan stack
+        int y;
+        do {
+          y = stack[--stackTop];
+          onStack[W->marks[y]] = false;
+          parts[numPopped++] = y;
+        } while (y != x);
+        partEnds[numParts++] = numPopped;
       }
-      else { // if v is greater than the current neighbor in the traversal
-	traversal = getNextNode(traversal); // move onto the next neighbor
+      if (pathTop > 0) {
+        int ip = W->marks[path[pathTop - 1]];
+        if (low[ix] < low[ip]) {
+          low[ip] = low[ix];
+        }
       }
     }
+  }
 
-    if (traversal == NULL) { // if v is greater than all the neighbors of u
-      G->numEdges++;
-      append(G->adjLists[u - 1], v - 1); // add v to the end of u's neighbor List
+  COUNT_STAT(verticesVisited, k);
+  COUNT_STAT(edgesScanned, scanned);
+  if (numParts > 1) {
+    COUNT_STAT(sccSplits, 1);
+    int largest = 0;
+    for (int p = 1; p < numParts; p++) {
+      if (partEnds[p] - partEnds[p - 1] > partEnds[largest] - (largest == 0 ? 0 : partEnds[largest - 1])) {
+        largest = p;
+      }
     }
+    int* ids = malloc(sizeof(int) * numParts); // Tarjan finds the parts in reverse topological order
+    int* added = malloc(sizeof(int) * numParts); // the new indices
+    int numAdded = 0;
+    G->componentHeads[c] = -1; // c's list is rebuilt from its largest part
+    for (int p = 0; p < numParts; p++) {
+      int id = c;
+      if (p != largest) {
+        id = G->freeComponents[--G->numFreeComponents];
+        added[numAdded++] = id;
+      }
+      ids[numParts - 1 - p] = id;
+      int start = p == 0 ? 0 : partEnds[p - 1];
+      for (int i = start; i < partEnds[p]; i++) {
+        G->componentIds[parts[i]] = id;
+        appendMember(G, id, parts[i]);
+      }
+      G->componentSizes[id] = partEnds[p] - start;
+    }
+    placeAllAfter(G->componentOrder, c, added, numAdded); // all at once, then the parts are put in order
+    permuteOrder(G->componentOrder, ids, numParts);
+    G->numSCCs += numParts - 1;
+    free(ids);
+    free(added);
   }
 
-  return 0;
+  free(low);
+  free(cursors);
+  free(onStack);
+  free(path);
+  free(stack);
+  free(parts);
+  free(partEnds);
+}
+
+/**
+ * deleteSCCEdge method that updates the cached SCC results after the edge (u, v) was deleted. Only the
+ * SCC that contained both u and v can split, and only if u can no longer reach v inside it; in that
+ * case just that SCC is recomputed. Deleting an edge between two SCCs changes nothing, since the
+ * topological order stays valid
+ *
+ * @param - G - the Digraph
+ * @param - u - the starting vertex of the deleted edge (0-based)
+ * @param - v - the ending vertex of the deleted edge (0-based)
+ */
+static void deleteSCCEdge(Digraph G, int u, int v) {
+  int c = G->componentIds[u];
+  if (c != G->componentIds[v] || u == v) {
+    return; // an edge between two SCCs (or a self loop) holds no SCC together
+  }
+  if (reachesWithin(G, u, v, c)) {
+    return; // every path that used (u, v) can go around it, so c is still strongly connected
+  }
+  splitSCC(G, c);
 }
 
 /**
@@ -234,200 +941,450 @@ int deleteEdge(Digraph G, int u, int v) {
   if (u > G->numVertices || v > G->numVertices) { // if u or v are greater than numVertices
     return -1; // illegal
   }
+  if (G->packed != NULL) { // a packed digraph is read-only, so go back to the NeighborSets first
+    unpackDigraph(G);
+  }
 
-  bool exists = false; // used to see if the v vertex exists in the u vertex's List of neighbors
-  Node currentU = getFront(G->adjLists[u - 1]); // set currentU to be the first Node in u's List of neighbors
+  if (!removeNeighbor(&G->adjSets[u - 1], v - 1)) { // if v is not in u's set of neighbors
+    return 1;
+  }
+  removeNeighbor(&G->inSets[v - 1], u - 1); // delete u from v's set of incoming neighbors
+  G->numEdges--;
+  bool cached = G->sccVersion == G->version; // whether the SCC results were up to date before this deletion
+  G->version++; // the edge set changed
+  if (cached) { // repair the cached SCC results instead of recomputing them later
+    deleteSCCEdge(G, u - 1, v - 1);
+    G->sccVersion = G->version;
+    COUNT_STAT(sccEdgeUpdates, 1);
+  }
+  return 0;
+}
 
-  if (currentU != NULL) { // if u has a List of neighbors
-    while(currentU != NULL) { // traverse through the List
-      if (getValue(currentU) == v - 1) { // if v is in u's List of neighbors
-        exists = true;
-        break;
-      }
-      currentU = getNextNode(currentU);;
-    }
+/**
+ * unvisitAll method that sets the marks of the first n vertices in W to be unvisited
+ *
+ * @param - W - the Workspace
+ * @param - n - the number of vertices
+ */
+static void unvisitAll(Workspace W, int n) {
+  for (int i = 0; i < n; i++) {
+    W->marks[i] = UNVISITED; // set every element in the marks array to be unvisited
   }
+}
 
-  if (exists) { // if v is in u's List of neighbors
-    G->numEdges--; 
-    detachNode(G->adjLists[u - 1], currentU); // detach the v Node
-    deleteNode(G->adjLists[u - 1], currentU); // delete the v Node
+/**
+ * finishFrom method that performs an iterative depth first search from vertex s, appending each vertex to
+ * the Workspace's order as soon as all of its neighbors are done. The DFS path is kept on the Workspace's
+ * stack (with the index of the next neighbor to look at for each vertex in its cursors) so long paths can't
+ * overflow the C stack
+ *
+ * @param - S - the CSR snapshot of the Digraph
+ * @param - W - the Workspace
+ * @param - s - the starting vertex (0-based)
+ * @param - count - the number of vertices already in order
+ * @return - the number of vertices in order after this search
+ */
+static int finishFrom(Snapshot S, Workspace W, int s, int count) {
+  int top = 0; // the number of vertices on the DFS path
+  W->stack[top++] = s;
+  W->marks[s] = INPROGRESS;
+  W->cursors[s] = S->outOffsets[s];
+
+  while (top > 0) {
+    int x = W->stack[top - 1]; // the vertex at the end of the DFS path
+    if (W->cursors[x] == S->outOffsets[x + 1]) { // if all of x's neighbors have been looked at
+      top--;
+      W->marks[x] = ALLDONE;
+      W->order[count++] = x; // x finishes now
+      continue;
+    }
+    int y = S->outTargets[W->cursors[x]++]; // move x's cursor onto its next neighbor
+    if (W->marks[y] == UNVISITED) { // if the neighbor is UNVISITED, extend the DFS path to it
+      W->marks[y] = INPROGRESS;
+      W->cursors[y] = S->outOffsets[y];
+      W->stack[top++] = y;
+    }
   }
+  return count;
+}
 
-  if (currentU == NULL) { // if u doesn't have a List of neighbors
-    return 1;
+/**
+ * collectSCC method that visits every UNVISITED vertex that can reach s in G (by following the transpose) and
+ * adds it to the SCC with index c
+ *
+ * @param - G - the Digraph
+ * @param - S - the CSR snapshot of G
+ * @param - W - the Workspace
+ * @param - s - the starting vertex (0-based)
+ * @param - c - the index of the SCC being collected
+ */
+static void collectSCC(Digraph G, Snapshot S, Workspace W, int s, int c) {
+  int top = 0; // the number of vertices waiting to have their neighbors looked at
+  int size = 0;
+  W->stack[top++] = s;
+  W->marks[s] = VISITED;
+
+  while (top > 0) {
+    int x = W->stack[--top];
+    appendMember(G, c, x); // x is in this SCC
+    G->componentIds[x] = c;
+    size++;
+    for (size_t e = S->inOffsets[x]; e < S->inOffsets[x + 1]; e++) { // push every UNVISITED incoming neighbor of x
+      int y = S->inTargets[e];
+      if (W->marks[y] == UNVISITED) {
+        W->marks[y] = VISITED;
+        W->stack[top++] = y;
+      }
+    }
   }
+  G->componentSizes[c] = size;
+}
 
-  if(!exists) { // if v is not in u's List of neighbors
-    return 1;
+/**
+ * finishFromPacked method that is finishFrom for a packed G, walking each neighbor list in place with the
+ * Workspace's PackedCursors instead of an index into a snapshot
+ *
+ * @param - G - the Digraph
+ * @param - W - the Workspace
+ * @param - s - the starting vertex (0-based)
+ * @param - count - the number of vertices already in order
+ * @return - the number of vertices in order after this search
+ */
+static int finishFromPacked(Digraph G, Workspace W, int s, int count) {
+  int top = 0;
+  W->stack[top++] = s;
+  W->marks[s] = INPROGRESS;
+  startNeighbors(G->packed, true, s, &W->packedCursors[s]);
+
+  while (top > 0) {
+    int x = W->stack[top - 1];
+    int y = nextNeighbor(G->packed, true, x, &W->packedCursors[x]);
+    if (y < 0) { // if all of x's neighbors have been looked at
+      top--;
+      W->marks[x] = ALLDONE;
+      W->order[count++] = x;
+      continue;
+    }
+    if (W->marks[y] == UNVISITED) {
+      W->marks[y] = INPROGRESS;
+      startNeighbors(G->packed, true, y, &W->packedCursors[y]);
+      W->stack[top++] = y;
+    }
   }
+  return count;
+}
 
-  return 0;
+/**
+ * collectSCCPacked method that is collectSCC for a packed G, decoding the incoming neighbors of each vertex
+ * into unpacked
+ *
+ * @param - G - the Digraph
+ * @param - W - the Workspace
+ * @param - s - the starting vertex (0-based)
+ * @param - c - the index of the SCC being collected
+ */
+static void collectSCCPacked(Digraph G, Workspace W, int s, int c) {
+  int top = 0;
+  int size = 0;
+  W->stack[top++] = s;
+  W->marks[s] = VISITED;
+
+  while (top > 0) {
+    int x = W->stack[--top];
+    appendMember(G, c, x);
+    G->componentIds[x] = c;
+    size++;
+    int degree = unpackNeighbors(G->packed, false, x, G->unpacked);
+    for (int i = 0; i < degree; i++) {
+      int y = G->unpacked[i];
+      if (W->marks[y] == UNVISITED) {
+        W->marks[y] = VISITED;
+        W->stack[top++] = y;
+      }
+    }
+  }
+  G->componentSizes[c] = size;
 }
 
 /**
- * visitAll method that sets every element in markers to be unvisited
+ * freezeDigraph method that returns a CSR snapshot of G. The snapshot is only rebuilt if the edge set
+ * has changed since the last freeze, by copying the sorted neighbor arrays of adjSets and inSets (the
+ * transpose) into one contiguous array each, or by decoding them from packed
  *
  * @param - G - the Digraph
+ * @return - the snapshot, which stays valid until the next addEdge or deleteEdge
  */
-void unvisitAll(Digraph G){
-  for (int i = 0; i < G->numVertices; i++) {
-    G->markers[i] = UNVISITED; // set every element in the markers array to be unvisited
+Snapshot freezeDigraph(Digraph G) {
+  if (G->snapshot != NULL && G->snapshotVersion == G->version) { // nothing has changed since the last freeze
+    return G->snapshot;
   }
+  if (G->snapshot == NULL) {
+    G->snapshot = newSnapshot(G->numVertices);
+  }
+  Snapshot S = G->snapshot;
+  reserveEdges(S, G->numEdges);
+  size_t at = 0;
+  if (G->packed != NULL) { // decode each list straight into place
+    for (int i = 0; i < G->numVertices; i++) {
+      S->outOffsets[i] = at;
+      at += unpackNeighbors(G->packed, true, i, S->outTargets + at);
+    }
+    S->outOffsets[G->numVertices] = at;
+    at = 0;
+    for (int i = 0; i < G->numVertices; i++) {
+      S->inOffsets[i] = at;
+      at += unpackNeighbors(G->packed, false, i, S->inTargets + at);
+    }
+    S->inOffsets[G->numVertices] = at;
+    G->snapshotVersion = G->version;
+    return S;
+  }
+  for (int i = 0; i < G->numVertices; i++) { // lay the neighbors of each vertex out one after another
+    const int* neighbors = sortedNeighbors(&G->adjSets[i]);
+    int degree = neighborCount(&G->adjSets[i]);
+    S->outOffsets[i] = at;
+    for (int j = 0; j < degree; j++) {
+      S->outTargets[at++] = neighbors[j];
+    }
+  }
+  S->outOffsets[G->numVertices] = at;
+  at = 0;
+  for (int i = 0; i < G->numVertices; i++) { // inSets already holds the transpose, so copy it the same way
+    const int* neighbors = sortedNeighbors(&G->inSets[i]);
+    int degree = neighborCount(&G->inSets[i]);
+    S->inOffsets[i] = at;
+    for (int j = 0; j < degree; j++) {
+      S->inTargets[at++] = neighbors[j];
+    }
+  }
+  S->inOffsets[G->numVertices] = at;
+  G->snapshotVersion = G->version;
+  return S;
 }
 
 /**
- * getMark method that returns the mark for vertex u
+ * allocateComponents method that allocates the SCC results of G the first time they are needed and empties
+ * the list of every SCC
  *
  * @param - G - the Digraph
- * @param - u - the vertex
- * @return - UNVISITED, INPROGRESS, or ALLDONE
  */
-int getMark(Digraph G, int u){
-  return G->markers[u-1];
+static void allocateComponents(Digraph G) {
+  if (G->componentIds == NULL) {
+    G->componentIds = malloc(sizeof(int) * G->numVertices);
+    G->componentSizes = malloc(sizeof(int) * G->numVertices);
+    G->componentHeads = malloc(sizeof(int) * G->numVertices);
+    G->componentTails = malloc(sizeof(int) * G->numVertices);
+    G->nextInComponent = malloc(sizeof(int) * G->numVertices);
+  }
+  for (int c = 0; c < G->numVertices; c++) {
+    G->componentHeads[c] = -1;
+  }
 }
 
 /**
- * setMark method that sets the mark for vertex u
+ * startOrder method that empties componentOrder (making it first if needed) so a new SCC computation with
+ * count SCCs can fill it in, and marks the indices from count up as unused
  *
  * @param - G - the Digraph
- * @paran - u - the vertex
- * @param - theMark - the mark to set u to
+ * @param - count - the number of SCCs
  */
-void setMark(Digraph G, int u, int theMark){
-  G->markers[u-1] = theMark;
+static void startOrder(Digraph G, int count) {
+  if (G->componentOrder == NULL) {
+    G->componentOrder = newOrderList(G->numVertices);
+    G->freeComponents = malloc(sizeof(int) * G->numVertices);
+  }
+  clearOrder(G->componentOrder);
+  G->numFreeComponents = 0;
+  for (int c = G->numVertices - 1; c >= count; c--) { // the unused indices hold empty SCCs
+    G->componentSizes[c] = 0;
+    G->freeComponents[G->numFreeComponents++] = c;
+  }
 }
 
 /**
- * DFS method that will be used for finding the SCCs and their properties
+ * parallelCountSCC method that finds the SCCs of the CSR snapshot with the parallel engine and fills in
+ * componentIds, componentSizes and the lists of the vertices of each SCC from its labelling. The engine
+ * is started the first time and its threads are reused by every later computation
  *
  * @param - G - the Digraph
- * @param - u - the starting vertex
- * @param - t - the current time
- * @return - the current time
+ * @return - the number of SCCs
  */
-int DFS(Digraph G, int u, int t) {
-  int currentTime = t;
-  G->times[u - 1] = currentTime;
-  currentTime++;
-  setMark(G, u, INPROGRESS); // set the current starting vertex as INPROGRESS
-  List L = getNeighbors(G, u);
+static int parallelCountSCC(Digraph G) {
+  int n = G->numVertices;
+  Snapshot S = freezeDigraph(G);
+  if (G->sccEngine == NULL) {
+    G->sccEngine = newSCCEngine(n, G->sccThreads);
+  }
+  int count = parallelSCC(G->sccEngine, S, G->componentIds);
+
+  for (int c = 0; c < n; c++) {
+    G->componentSizes[c] = 0;
+  }
+  for (int i = 0; i < n; i++) { // add each vertex to its SCC
+    int c = G->componentIds[i];
+    appendMember(G, c, i);
+    G->componentSizes[c]++;
+  }
 
-  Node current = getFront(L);
-  while (current != NULL) { // traverse through the neighbors of the current vertex
-    if (getMark(G, getValue(current) + 1) == UNVISITED) { // if the neighbor is UNVISITED
-      prepend(G->currentSCCList, getValue(current) + 1); // add this vertex to the current SCC List
-      currentTime = DFS(G, getValue(current) + 1, currentTime); // set the neighbor as the next starting point
-      currentTime++;
+  // Kahn's algorithm on the SCCs gives the topological order that insertSCCEdge keeps up to date
+  int* inDegrees = calloc(count, sizeof(int)); // the number of edges into each SCC from other SCCs
+  int* queue = malloc(sizeof(int) * (count + 1)); // the SCCs whose incoming edges are all done
+  for (size_t e = 0; e < S->numEdges; e++) {
+    inDegrees[G->componentIds[S->outTargets[e]]]++;
+  }
+  for (int i = 0; i < n; i++) { // edges inside an SCC don't count
+    for (size_t e = S->outOffsets[i]; e < S->outOffsets[i + 1]; e++) {
+      if (G->componentIds[S->outTargets[e]] == G->componentIds[i]) {
+        inDegrees[G->componentIds[i]]--;
+      }
     }
-    current = getNextNode(current);
   }
-  if (currentTime > G->largestFinishTime) { // set the largestFinishTime
-    G->largestFinishTime = currentTime;
+  int head = 0;
+  int tail = 0;
+  for (int c = 0; c < count; c++) {
+    if (inDegrees[c] == 0) {
+      queue[tail++] = c;
+    }
   }
-  if (currentTime < G->lowestFinishTime) { // set the lowestFinishTime
-    G->lowestFinishTime = currentTime;
+  startOrder(G, count);
+  while (head < tail) {
+    int c = queue[head++];
+    placeLast(G->componentOrder, c);
+    for (int x = G->componentHeads[c]; x >= 0; x = G->nextInComponent[x]) { // release the SCCs c has edges into
+      for (size_t e = S->outOffsets[x]; e < S->outOffsets[x + 1]; e++) {
+        int d = G->componentIds[S->outTargets[e]];
+        if (d != c && --inDegrees[d] == 0) {
+          queue[tail++] = d;
+        }
+      }
+    }
   }
-
-  G->finishTimes[u - 1] = currentTime; // keep track of each vertex's finish time
-  G->markers[u - 1] = ALLDONE; // if all of the current vertex's neighbors are visited, mark the current vertex as ALLDONE
-  return currentTime;
+  free(inDegrees);
+  free(queue);
+  return count;
 }
 
 /**
- * getCountSCC method that returns the number of SCCs in G. Also creates the SCCLists array for numSCCVertices and inSameSCC
+ * getCountSCC method that returns the number of SCCs in G. Also fills in the list of the vertices of
+ * each SCC and the componentIds/componentSizes cache for numSCCVertices and inSameSCC. The SCCs are
+ * only recomputed if the edge set has changed since the last call
+ *
+ * Kosaraju's algorithm is used: a DFS over G records the order the vertices finish in, then each
+ * UNVISITED vertex, taken in decreasing finish order, starts a new SCC that contains everything it can
+ * still reach by following the reversed edges. Both passes are iterative and run in O(V + E). They
+ * run on the CSR snapshot from freezeDigraph, so following an edge is a read from one contiguous array
+ * (the reversed edges come from its transpose).
+ *
+ * If setSCCThreads asked for more than one thread, the parallel engine in ParallelSCC.c is used
+ * instead. It finds the same SCCs, numbered in the order of their smallest vertex
  *
  * @param - G - the Digraph
  * @return - the number of SCCs
 */
 int getCountSCC(Digraph G) {
-  unvisitAll(G); // reset the markers of the Digraph
+  if (G->sccVersion == G->version) { // if no edges have been added or deleted since the last computation
+    return G->numSCCs; // the cached results are still valid
+  }
+
   G->numSCCs = 0; // reset numSCCs to 0
-  G->largestFinishTime = -1;
-  G->lowestFinishTime = 999999;
+  COUNT_STAT(sccRecomputations, 1);
+  COUNT_STAT(verticesVisited, 2LL * G->numVertices); // both engines look at every vertex and edge
+  COUNT_STAT(edgesScanned, 2LL * G->numEdges); // once in each direction
 
-  for (int e = 0; e < G->numVertices; e++) { // clear each SCCList in SCCLists
-    clear(G->SCCLists[e]);
-  }
+  allocateComponents(G);
+  G->sccUpdateBudget = SCC_UPDATE_BUDGET * ((long long) G->numVertices + G->numEdges);
 
-  for (int i = 0; i < getOrder(G); i++) { // perform DFS on every vertex in G to find the finish times
-    if (G->markers[i] == UNVISITED) {
-      G->times[i] = G->largestFinishTime + 1; // when DFS moves onto the next UNVISITED vertex, the start time for it is +1 over the current largest finish time
-      DFS(G, i + 1, G->times[i]); // perform depth first search on all unvisited vertices
-    }
+  if (G->sccThreads > 1 && G->packed == NULL) { // the parallel engine needs a snapshot, which a packed G doesn't keep
+    G->numSCCs = parallelCountSCC(G);
+    G->sccVersion = G->version;
+    return G->numSCCs;
   }
 
-  Digraph RG = newDigraph(G->numVertices); // this will be used to find the number of SCCs in G
-  for(int i = 0; i < G->numVertices; i++) { // create a new graph that is G but with all the edges reversed
-    Node current = getFront(G->adjLists[i]);
-    while (current != NULL) {
-      append(RG->adjLists[getValue(current)], i);
-      current = getNextNode(current);
+  bool packed = G->packed != NULL; // a packed G is searched in place, without a snapshot
+  Snapshot S = packed ? NULL : freezeDigraph(G); // both passes read the CSR copy of the edges
+  Workspace W = useWorkspace(G); // the marks, the finish order, the DFS stack and its cursors
+
+  unvisitAll(W, G->numVertices); // reset the marks of the Digraph
+  int count = 0; // the number of vertices that have finished
+  for (int i = 0; i < getOrder(G); i++) { // perform DFS on every vertex in G to find the finish order
+    if (W->marks[i] == UNVISITED) {
+      count = packed ? finishFromPacked(G, W, i, count) : finishFrom(S, W, i, count);
     }
   }
 
-  //RG is created so that the actual Digraph G isn't altered
-  unvisitAll(RG); // set all the vertices in RG to be UNVISITED
-  int k = 0; // used to iterate through the SCCLists array
-  for (int i = G->largestFinishTime; i >= G->lowestFinishTime; i--) { // set i to be the largest finish time of G and decrement lower to the next highest finish time
-    int startingPoint = 0;
-    for (int j = 0; j < G->numVertices; j++) {
-      if (G->finishTimes[j] == i) {
-	startingPoint = j; // set the starting point to be the current largest finish time
+  unvisitAll(W, G->numVertices); // reset the marks for the search over the reversed edges
+  for (int i = count - 1; i >= 0; i--) { // take the vertices from the latest finish to the earliest
+    int startingPoint = W->order[i];
+    if (W->marks[startingPoint] == UNVISITED) { // if this starting point is UNVISITED, this is a new SCC in G
+      if (packed) {
+        collectSCCPacked(G, W, startingPoint, G->numSCCs);
       }
-    }
-    if (RG->markers[startingPoint] == UNVISITED) { // if this starting point is UNVISITED, this is a new SCC in G
-      G->numSCCs++; // increment numSCC in G
-      clear(RG->currentSCCList); // reset currentSCCList for this current SCC in G
-      prepend(RG->currentSCCList, startingPoint + 1); // prepend the starting point into this current SCCList
-      DFS(RG, startingPoint + 1, RG->times[startingPoint]); // perform depth first search starting from this current starting point, creating this current SCCList
-
-      Node newcurrent = getFront(RG->currentSCCList);
-      while (newcurrent != NULL) {
-	append(G->SCCLists[k], getValue(newcurrent)); // add this currentSCCList to the SCCLists array
-	newcurrent = getNextNode(newcurrent);
+      else {
+        collectSCC(G, S, W, startingPoint, G->numSCCs);
       }
-      k++; // move onto the next index in the SCCLists array so that the next SCCList can be added into it                                                                                     
+      G->numSCCs++; // increment numSCC in G
     }
   }
 
-  // RG has been used to create the SCCLists array, so it's job is finished
-  freeDigraph(&RG);
+  startOrder(G, G->numSCCs);
+  for (int c = 0; c < G->numSCCs; c++) { // Kosaraju collects the SCCs in topological order
+    placeLast(G->componentOrder, c);
+  }
+  G->sccVersion = G->version; // the cache now matches the current edge set
   return G->numSCCs;
 }
 
 /**
- * getNumSCCVertices method that returns the number of vertices in the SCC that contains vertex u in G
+ * setSCCThreads method that sets the number of threads getCountSCC uses. An engine started with a
+ * different number of threads is stopped, and the next parallel computation starts a new one
+ *
+ * @param - G - the Digraph
+ * @param - numThreads - the number of threads (1 for the sequential algorithm)
+ */
+void setSCCThreads(Digraph G, int numThreads) {
+  numThreads = numThreads < 1 ? 1 : numThreads;
+  if (G->sccEngine != NULL && numThreads != G->sccThreads) {
+    freeSCCEngine(&G->sccEngine);
+  }
+  G->sccThreads = numThreads;
+}
+
+/**
+ * forgetSCCs method that drops the cached SCC results, so edges are added and deleted without keeping them
+ * up to date and the next query finds them again
+ *
+ * @param - G - the Digraph
+ */
+void forgetSCCs(Digraph G) {
+  G->sccVersion = -1;
+}
+
+/**
+ * getNumSCCVertices method that returns the number of vertices in the SCC that contains vertex u in G.
+ * This is a lookup into the cached SCC results
  *
  * @param - G - the Digraph
  * @param - u - the vertex
- * @return - the number of vertices in the SCC that contains u
+ * @return - the number of vertices in the SCC that contains u, or -1 if u is an illegal vertex
  */
 int getNumSCCVertices(Digraph G, int u) {
-  getCountSCC(G); // create the SCCLists array, which contains each SCC in G and the respective vertices in each SCC
-  int num = 0;
-
-  for (int i = 0; i < G->numVertices; i++) { // find u in SCCLists
-    Node current = getFront(G->SCCLists[i]);
-    while (current != NULL) {
-      if (getValue(current) == u) {
-	num = length(G->SCCLists[i]); // the length of the SCCList that u is in is the number of vertices in the SCC
-      }
-      current = getNextNode(current);
-    }
+  if (u < 1 || u > G->numVertices) { // if u is outside 1 .. numVertices
+    return -1; // illegal
   }
-    return num;
+  getCountSCC(G); // make sure the cached SCC results are up to date
+  return G->componentSizes[G->componentIds[u - 1]]; // the size of the SCC that u is in
 }
 
 /**
- * inSameSCC method that returns 1 if u and v are in the same SCC, 0 if they are not, and -1 if they are illegal vertices
+ * inSameSCC method that returns 1 if u and v are in the same SCC, 0 if they are not, and -1 if they are illegal vertices.
+ * This is a lookup into the cached SCC results
  *
  * @param - G - the Digraph
  * @param - u - a vertex
  * @param - v - another vertex
  */
 int inSameSCC (Digraph G, int u, int v) {
-  getCountSCC(G); // create the SCCLists array, which contains each SCC in G and the respective vertices in each SCC
+  getCountSCC(G); // make sure the cached SCC results are up to date
   if (u == v) { // if u and v are the same vertex
     return 1; // they are in the same SCC
   }
@@ -438,34 +1395,303 @@ int inSameSCC (Digraph G, int u, int v) {
     return -1; // illegal
   }
 
-  bool uExists = false; // used to check if u is in an SCC List
-  bool vExists = false; // used to check if v is in an SCC List
-  for (int i = 0; i < G->numVertices; i++) {
-    Node current = getFront(G->SCCLists[i]);
-    while (current != NULL) { // iterate through each SCCList in the SCCLists array
-      if (getValue(current) == u) { // if u exists in the current SCCList
-	uExists = true;
-      }
-      else if (getValue(current) == v) { // if v exists in the current SCCList
-	vExists = true;
+  return G->componentIds[u - 1] == G->componentIds[v - 1]; // compare the cached SCCs of u and v
+}
+
+/**
+ * inSameSCCBatch method that answers inSameSCC for every pair (us[i], vs[i]) from a single SCC computation
+ *
+ * @param - G - the Digraph
+ * @param - us - the first vertex of each pair
+ * @param - vs - the second vertex of each pair
+ * @param - results - where inSameSCC(G, us[i], vs[i]) is stored for each pair
+ * @param - n - the number of pairs
+ */
+void inSameSCCBatch(Digraph G, const int* us, const int* vs, int* results, int n) {
+  getCountSCC(G); // one computation (or none, if the cache is valid) for the whole batch
+  for (int i = 0; i < n; i++) {
+    int u = us[i];
+    int v = vs[i];
+    if (u == v) { // a vertex is always in the same SCC as itself
+      results[i] = 1;
+    }
+    else if (u < 1 || v < 1 || u > G->numVertices || v > G->numVertices) { // illegal vertices
+      results[i] = -1;
+    }
+    else {
+      results[i] = G->componentIds[u - 1] == G->componentIds[v - 1];
+    }
+  }
+}
+
+/**
+ * rankComponents method that brings topoRanks up to date by walking componentOrder, so topoRanks[c] is
+ * the position (0-based) of SCC c in the order
+ *
+ * @param - G - the Digraph
+ */
+static void rankComponents(Digraph G) {
+  getCountSCC(G); // make sure the SCCs and their order are up to date
+  if (G->rankVersion == G->version) {
+    return;
+  }
+  if (G->topoRanks == NULL) {
+    G->topoRanks = malloc(sizeof(int) * G->numVertices);
+  }
+  int rank = 0;
+  for (int c = firstPlaced(G->componentOrder); c >= 0; c = nextPlaced(G->componentOrder, c)) {
+    G->topoRanks[c] = rank++;
+  }
+  G->rankVersion = G->version;
+}
+
+/**
+ * sortTargets method that puts the targets of every SCC of C in ascending order in O(numComponents +
+ * numEdges), by bucketing the edges by target and then handing each target back to its sources in
+ * ascending order. Only the edges of the condensation are moved, not the edges of G
+ *
+ * @param - C - the Condensation, with the targets of each SCC in any order
+ * @param - filled - room for numComponents ints
+ */
+static void sortTargets(Condensation C, int* filled) {
+  int k = C->numComponents;
+  size_t* inOffsets = calloc((size_t) k + 1, sizeof(size_t)); // where the sources of each target start
+  int* sources = malloc(sizeof(int) * (C->numEdges + 1));
+  for (size_t e = 0; e < C->numEdges; e++) {
+    inOffsets[C->targets[e] + 1]++;
+  }
+  for (int d = 0; d < k; d++) {
+    inOffsets[d + 1] += inOffsets[d];
+  }
+  for (int s = 0; s < k; s++) { // inOffsets[d] moves on to where the sources of d end
+    for (size_t e = C->offsets[s]; e < C->offsets[s + 1]; e++) {
+      sources[inOffsets[C->targets[e]]++] = s;
+    }
+    filled[s] = 0;
+  }
+  size_t at = 0;
+  for (int d = 0; d < k; d++) { // targets taken in ascending order end up in ascending order
+    for (; at < inOffsets[d]; at++) {
+      int s = sources[at];
+      C->targets[C->offsets[s] + filled[s]++] = d;
+    }
+  }
+  free(inOffsets);
+  free(sources);
+}
+
+/**
+ * condenseDigraph method that returns the condensation DAG of G with its SCCs numbered in topological
+ * order. The SCCs are visited in that order, and the edges out of each one are collected from the edges
+ * of its vertices, with the rank of the SCC stored in the Workspace's order[d] once SCC d is a target, so that
+ * every edge between two SCCs is kept only once. sortTargets then orders each SCC's targets, so the
+ * whole condensation is built in O(V + E)
+ *
+ * @param - G - the Digraph
+ * @return - the Condensation, owned by G
+ */
+Condensation condenseDigraph(Digraph G) {
+  rankComponents(G);
+  if (G->condensation != NULL && G->condensationVersion == G->version) { // nothing has changed since it was built
+    return G->condensation;
+  }
+  if (G->condensation == NULL) {
+    G->condensation = newCondensation(G->numVertices);
+  }
+  Condensation C = G->condensation;
+  C->numComponents = G->numSCCs;
+  for (int x = 0; x < G->numVertices; x++) {
+    C->componentIds[x] = G->topoRanks[G->componentIds[x]];
+  }
+  int* targetOf = useWorkspace(G)->order; // the last SCC each SCC was found to be a target of
+  for (int r = 0; r < C->numComponents; r++) {
+    targetOf[r] = -1;
+  }
+
+  size_t at = 0;
+  int r = 0;
+  for (int c = firstPlaced(G->componentOrder); c >= 0; c = nextPlaced(G->componentOrder, c), r++) {
+    C->componentSizes[r] = G->componentSizes[c];
+    C->offsets[r] = at;
+    for (int x = G->componentHeads[c]; x >= 0; x = G->nextInComponent[x]) { // every vertex of the SCC
+      int degree;
+      const int* neighbors = neighborsOf(G, x, true, &degree);
+      for (int i = 0; i < degree; i++) {
+        int d = C->componentIds[neighbors[i]];
+        if (d == r || targetOf[d] == r) { // inside the SCC, or already a target
+          continue;
+        }
+        targetOf[d] = r;
+        if (at == C->edgeCapacity) {
+          reserveCondensationEdges(C, at + 1);
+        }
+        C->targets[at++] = d;
       }
-      current = getNextNode(current);
     }
+  }
+  C->offsets[C->numComponents] = at;
+  C->numEdges = at;
+  sortTargets(C, targetOf);
+  G->condensationVersion = G->version;
+  return C;
+}
+
+/**
+ * getCondensationSize method that returns the number of edges between SCCs in the condensation of G
+ *
+ * @param - G - the Digraph
+ * @return - the number of edges of the condensation
+ */
+long long getCondensationSize(Digraph G) {
+  return (long long) condenseDigraph(G)->numEdges;
+}
+
+/**
+ * getTopoRank method that returns the position (1-based) of u's SCC in a topological order of the SCCs
+ *
+ * @param - G - the Digraph
+ * @param - u - the vertex
+ * @return - the rank, or -1 if u is not a legal vertex
+ */
+int getTopoRank(Digraph G, int u) {
+  if (u < 1 || u > G->numVertices) {
+    return -1;
+  }
+  rankComponents(G);
+  return G->topoRanks[G->componentIds[u - 1]] + 1;
+}
+
+/**
+ * currentClosure method that returns the transitive closure of C, rebuilding it if G changed since it
+ * was built, or NULL if it wouldn't fit in closureLimit
+ *
+ * @param - G - the Digraph
+ * @param - C - the condensation of G
+ * @return - the Closure, or NULL
+ */
+static Closure currentClosure(Digraph G, Condensation C) {
+  if (G->closureLimit == 0 || closureBytes(C->numComponents) > G->closureLimit) {
+    return NULL;
+  }
+  if (G->closure != NULL && G->closureVersion == G->version) {
+    return G->closure;
+  }
+  if (G->closure != NULL) {
+    freeClosure(&G->closure);
+  }
+  G->closure = newClosure(C);
+  G->closureVersion = G->version;
+  return G->closure;
+}
+
+/**
+ * canReach method that returns whether there is a path from u to v in G. Vertices in the same SCC always
+ * reach each other; anything else is a question about their SCCs in the condensation, which the
+ * ReachIndex answers, relabelling the condensation first if G changed since it was last labelled
+ *
+ * @param - G - the Digraph
+ * @param - u - the starting vertex
+ * @param - v - the vertex to reach
+ * @return - 1 if u reaches v, 0 if it doesn't, and -1 if u or v is not a legal vertex
+ */
+int canReach(Digraph G, int u, int v) {
+  if (u < 1 || v < 1 || u > G->numVertices || v > G->numVertices) {
+    return -1;
+  }
+  getCountSCC(G);
+  if (G->componentIds[u - 1] == G->componentIds[v - 1]) {
+    return 1;
+  }
+  Condensation C = condenseDigraph(G);
+  Closure T = currentClosure(G, C);
+  if (T != NULL) {
+    return closureReaches(T, C->componentIds[u - 1], C->componentIds[v - 1]);
+  }
+  if (G->reachIndex == NULL) {
+    G->reachIndex = newReachIndex(G->numVertices);
+  }
+  if (G->reachVersion != G->version) {
+    buildReachIndex(G->reachIndex, C, (unsigned) G->version + 1);
+    G->reachVersion = G->version;
+  }
+  return reaches(G->reachIndex, C, C->componentIds[u - 1], C->componentIds[v - 1]);
+}
 
-    if (uExists && vExists) { // if both u and v are in the current SCCList, they are in the same SCC
-      break;
+/**
+ * getReachableCount method that returns the number of vertices u can reach. This is a lookup into the
+ * transitive closure when one fits in closureLimit, and otherwise a depth first search of the
+ * condensation from u's SCC that adds up the sizes of the SCCs it reaches
+ *
+ * @param - G - the Digraph
+ * @param - u - the vertex
+ * @return - the number of vertices u reaches (including u), or -1 if u is not a legal vertex
+ */
+int getReachableCount(Digraph G, int u) {
+  if (u < 1 || u > G->numVertices) {
+    return -1;
+  }
+  Condensation C = condenseDigraph(G);
+  int a = C->componentIds[u - 1];
+  Closure T = currentClosure(G, C);
+  if (T != NULL) {
+    return closureReachCount(T, a);
+  }
+  bool* reached = calloc(C->numComponents, sizeof(bool));
+  int* stack = malloc(sizeof(int) * C->numComponents);
+  int top = 0;
+  int count = 0;
+  reached[a] = true;
+  stack[top++] = a;
+  while (top > 0) {
+    int x = stack[--top];
+    count += C->componentSizes[x];
+    for (size_t e = C->offsets[x]; e < C->offsets[x + 1]; e++) {
+      int y = C->targets[e];
+      if (!reached[y]) {
+        reached[y] = true;
+        stack[top++] = y;
+      }
     }
-    else { // if both u and v aren't found in the SCCList
-      uExists = false;
-      vExists = false;
-    } // move onto the next SCCList in the SCCLists array
   }
+  free(reached);
+  free(stack);
+  return count;
+}
 
-  if (uExists && vExists) {
-    return 1; // they are in the same SCC
+/**
+ * setClosureLimit method that sets the most memory the transitive closure may use
+ *
+ * @param - G - the Digraph
+ * @param - bytes - the limit (0 to never build a closure)
+ */
+void setClosureLimit(Digraph G, size_t bytes) {
+  G->closureLimit = bytes;
+  if (G->closure != NULL) { // the next query builds a new one if it fits
+    freeClosure(&G->closure);
+    G->closureVersion = -1;
   }
+}
 
-  return 0; // u and v are not in the same SCC
+/**
+ * writeDigraph method that writes the Digraph to W in the same format as an input line. Edges
+ * are written in sorted order
+ *
+ * @param - W - the Writer
+ * @param - G - the Digraph
+ */
+void writeDigraph(Writer W, Digraph G) {
+  writeInt(W, G->numVertices); // first write numVertices
+  for (int i = 0; i < getOrder(G); i++) { // iterate through the adjSets array
+    int degree;
+    const int* neighbors = neighborsOf(G, i, true, &degree);
+    for (int j = 0; j < degree; j++) { // traverse through each set of neighbors in ascending order
+      writeChars(W, ", ", 2);
+      writeInt(W, i + 1);
+      writeChar(W, ' ');
+      writeInt(W, neighbors[j] + 1);
+    }
+  }
+  writeChar(W, '\n');
 }
 
 /**
@@ -476,13 +1702,387 @@ int inSameSCC (Digraph G, int u, int v) {
  * @param - G - the Digraph
  */
 void printDigraph(FILE* out, Digraph G) {
-  fprintf(out, "%d", G->numVertices); // first print numVertices
-  for (int i = 0; i < getOrder(G); i++) { // iterate through the adjLists array
-    Node current = getFront(G->adjLists[i]);
-    while(current != NULL) { // traverse through each neighbors List
-      fprintf(out, ", %d %d", i + 1, getValue(current) + 1);
-      current = getNextNode(current);
+  Writer W = newWriter(out, 0);
+  writeDigraph(W, G);
+  freeWriter(&W); // flushes everything to out
+}
+
+/**
+ * binaryLayout method that returns where each array of a binary digraph file with numVertices vertices
+ * and numEdges edges starts
+ */
+static BinaryLayout binaryLayout(int numVertices, size_t numEdges) {
+  BinaryLayout L;
+  L.outOffsets = sizeof(BinaryHeader);
+  L.outTargets = L.outOffsets + sizeof(uint64_t) * ((size_t) numVertices + 1);
+  L.inOffsets = (L.outTargets + sizeof(int32_t) * numEdges + 7) / 8 * 8; // keep the offsets 8 byte aligned
+  L.inTargets = L.inOffsets + sizeof(uint64_t) * ((size_t) numVertices + 1);
+  L.size = L.inTargets + sizeof(int32_t) * numEdges;
+  L.scc = L.size;
+  return L;
+}
+
+/**
+ * hashWords method that continues the FNV-1a hash of an SCC labelling with its next count words, a byte
+ * at a time like the records of a Journal
+ *
+ * @param - hash - the hash of the words before these (2166136261 before the first)
+ * @param - words - the words
+ * @param - count - the number of words
+ * @return - the hash of the words up to and including these
+ */
+static uint32_t hashWords(uint32_t hash, const int32_t* words, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    for (int b = 0; b < 4; b++) {
+      hash = (hash ^ (((uint32_t) words[i] >> (8 * b)) & 0xFF)) * 16777619u;
     }
   }
-  fprintf(out, "\n");
+  return hash;
+}
+
+/**
+ * writeSCCs method that writes the SCC labelling of G (which has to be up to date) and its hash the way a
+ * BINARY_SCC_VERSION file holds them. The Workspace holds each array while it is written
+ *
+ * @param - out - the file to be written to
+ * @param - G - the Digraph
+ * @return - whether every write succeeded
+ */
+static bool writeSCCs(FILE* out, Digraph G) {
+  Workspace W = useWorkspace(G);
+  int32_t counts[2] = {G->numSCCs, G->numFreeComponents};
+  int r = 0;
+  int at = 0;
+  for (int c = firstPlaced(G->componentOrder); c >= 0; c = nextPlaced(G->componentOrder, c), r++) {
+    W->order[r] = c;
+    W->stack[r] = G->componentSizes[c];
+    for (int x = G->componentHeads[c]; x >= 0; x = G->nextInComponent[x]) {
+      W->marks[at++] = x;
+    }
+  }
+  size_t numSCCs = (size_t) G->numSCCs;
+  size_t n = (size_t) G->numVertices;
+  size_t numFree = (size_t) G->numFreeComponents;
+  uint32_t hash = hashWords(2166136261u, counts, 2);
+  hash = hashWords(hash, W->order, numSCCs);
+  hash = hashWords(hash, W->stack, numSCCs);
+  hash = hashWords(hash, W->marks, n);
+  hash = hashWords(hash, G->freeComponents, numFree);
+  bool ok = fwrite(counts, sizeof(int32_t), 2, out) == 2;
+  ok = ok && fwrite(W->order, sizeof(int), numSCCs, out) == numSCCs;
+  ok = ok && fwrite(W->stack, sizeof(int), numSCCs, out) == numSCCs;
+  ok = ok && fwrite(W->marks, sizeof(int), n, out) == n;
+  ok = ok && fwrite(G->freeComponents, sizeof(int), numFree, out) == numFree;
+  ok = ok && fwrite(&hash, sizeof(uint32_t), 1, out) == 1;
+  return ok;
+}
+
+/**
+ * writeBinary method that writes G to out in the binary format that mapBinaryDigraph loads, with its SCC
+ * labelling if withSCCs is true
+ *
+ * @param - out - the file to be written to (opened in binary mode)
+ * @param - G - the Digraph
+ * @param - withSCCs - whether the SCC labelling is written too (it is computed first if it isn't cached)
+ * @return - 0 on success, -1 if writing failed
+ */
+static int writeBinary(FILE* out, Digraph G, bool withSCCs) {
+  if (withSCCs) {
+    getCountSCC(G);
+  }
+  Snapshot S = freezeDigraph(G); // the file is just the snapshot's arrays behind a header
+  BinaryHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, BINARY_MAGIC, sizeof(header.magic));
+  header.formatVersion = withSCCs ? BINARY_SCC_VERSION : BINARY_FORMAT_VERSION;
+  header.byteOrder = BINARY_BYTE_ORDER;
+  header.numVertices = G->numVertices;
+  header.numEdges = S->numEdges;
+  BinaryLayout L = binaryLayout(G->numVertices, S->numEdges);
+  size_t n = (size_t) G->numVertices + 1;
+  uint64_t padding = 0;
+  size_t paddingLength = L.inOffsets - (L.outTargets + sizeof(int32_t) * S->numEdges);
+
+  int ok = fwrite(&header, sizeof(header), 1, out) == 1;
+  ok = ok && fwrite(S->outOffsets, sizeof(size_t), n, out) == n;
+  ok = ok && (S->numEdges == 0 || fwrite(S->outTargets, sizeof(int), S->numEdges, out) == S->numEdges); // NULL without edges
+  ok = ok && fwrite(&padding, 1, paddingLength, out) == paddingLength;
+  ok = ok && fwrite(S->inOffsets, sizeof(size_t), n, out) == n;
+  ok = ok && (S->numEdges == 0 || fwrite(S->inTargets, sizeof(int), S->numEdges, out) == S->numEdges);
+  ok = ok && (!withSCCs || writeSCCs(out, G));
+  ok = ok && fflush(out) == 0;
+  return ok ? 0 : -1;
+}
+
+/**
+ * writeBinaryDigraph method that writes G to out in the binary format that mapBinaryDigraph loads
+ *
+ * @param - out - the file to be written to (opened in binary mode)
+ * @param - G - the Digraph
+ * @return - 0 on success, -1 if writing failed
+ */
+int writeBinaryDigraph(FILE* out, Digraph G) {
+  return writeBinary(out, G, false);
+}
+
+/**
+ * writeCheckpoint method that writes G to out in the binary format followed by its SCC labelling, which
+ * mapBinaryDigraph restores so that the SCCs don't have to be found again
+ *
+ * @param - out - the file to be written to (opened in binary mode)
+ * @param - G - the Digraph
+ * @return - 0 on success, -1 if writing failed
+ */
+int writeCheckpoint(FILE* out, Digraph G) {
+  return writeBinary(out, G, true);
+}
+
+/**
+ * validOffsets method that returns whether offsets is a legal CSR offsets array for numVertices vertices
+ * and numEdges edges, with no vertex having more than INT_MAX neighbors
+ */
+static bool validOffsets(const size_t* offsets, int numVertices, size_t numEdges) {
+  if (offsets[0] != 0 || offsets[numVertices] != numEdges) {
+    return false;
+  }
+  for (int i = 0; i < numVertices; i++) {
+    if (offsets[i + 1] < offsets[i] || offsets[i + 1] - offsets[i] > INT_MAX) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * validTargets method that returns whether the targets of a mapped file describe a digraph: every outgoing
+ * list is strictly ascending and in range, and the incoming lists are exactly its transpose. The outgoing
+ * lists are walked in order of their vertex, so each incoming list must be met in ascending order, and a
+ * cursor per vertex checks it in one pass over the edges. The same pass checks that no edge goes back in
+ * the topological order of a stored SCC labelling
+ *
+ * @param - ranks - the topological rank of the SCC of each vertex in the stored labelling (NULL if none)
+ * @param - ordered - set to false if an edge goes from an SCC to one ranked before it
+ * @return - whether the targets are legal
+ */
+static bool validTargets(const size_t* outOffsets, const int* outTargets, const size_t* inOffsets,
+    const int* inTargets, int numVertices, const int* ranks, bool* ordered) {
+  size_t* cursors = malloc(sizeof(size_t) * numVertices); // where the next source of each vertex is expected
+  memcpy(cursors, inOffsets, sizeof(size_t) * numVertices);
+  bool ok = true;
+  for (int x = 0; x < numVertices && ok; x++) {
+    for (size_t i = outOffsets[x]; i < outOffsets[x + 1]; i++) {
+      int y = outTargets[i];
+      if (y < 0 || y >= numVertices || (i > outOffsets[x] && y <= outTargets[i - 1])
+          || cursors[y] == inOffsets[y + 1] || inTargets[cursors[y]] != x) {
+        ok = false;
+        break;
+      }
+      cursors[y]++;
+      if (ranks != NULL && ranks[x] > ranks[y]) {
+        *ordered = false;
+      }
+    }
+  }
+  for (int y = 0; y < numVertices && ok; y++) { // every incoming edge was met
+    ok = cursors[y] == inOffsets[y + 1];
+  }
+  free(cursors);
+  return ok;
+}
+
+/**
+ * sccLabellingSize method that returns the size of the SCC labelling (and its hash, if it has one) that
+ * starts at byte at of a mapped checkpoint of size bytes, or 0 if its counts don't fit the file
+ */
+static size_t sccLabellingSize(const char* base, size_t at, size_t size, int numVertices, bool hashed) {
+  if (size < at + 2 * sizeof(int32_t)) {
+    return 0;
+  }
+  const int32_t* counts = (const int32_t*) (base + at);
+  if (counts[0] < 1 || counts[0] > numVertices || counts[1] < 0 || counts[1] > numVertices) {
+    return 0;
+  }
+  return sizeof(int32_t) * (2 + 2 * (size_t) counts[0] + (size_t) numVertices + (size_t) counts[1])
+      + (hashed ? sizeof(uint32_t) : 0);
+}
+
+/**
+ * labellingIntact method that returns whether the SCC labelling of labellingSize bytes (its hash included)
+ * that starts at byte at of a mapped BINARY_SCC_VERSION file still has the hash it was written with
+ */
+static bool labellingIntact(const char* base, size_t at, size_t labellingSize) {
+  size_t count = (labellingSize - sizeof(uint32_t)) / sizeof(int32_t);
+  uint32_t hash;
+  memcpy(&hash, base + at + sizeof(int32_t) * count, sizeof(uint32_t));
+  return hashWords(2166136261u, (const int32_t*) (base + at), count) == hash;
+}
+
+/**
+ * labelledRanks method that returns the topological rank each vertex's SCC has in a stored SCC labelling,
+ * for validTargets to check the edges against, or NULL if the labelling places a vertex out of range
+ * (restoreSCCs checks the rest of it)
+ */
+static int* labelledRanks(const int32_t* labelling, int numVertices) {
+  int numSCCs = labelling[0];
+  const int32_t* sizes = labelling + 2 + numSCCs;
+  const int32_t* members = sizes + numSCCs;
+  int* ranks = calloc(numVertices, sizeof(int));
+  int at = 0; // the number of vertices ranked so far
+  for (int r = 0; r < numSCCs; r++) {
+    if (sizes[r] < 1 || sizes[r] > numVertices - at) {
+      free(ranks);
+      return NULL;
+    }
+    for (int k = 0; k < sizes[r]; k++, at++) {
+      int x = members[at];
+      if (x < 0 || x >= numVertices) {
+        free(ranks);
+        return NULL;
+      }
+      ranks[x] = r;
+    }
+  }
+  return ranks;
+}
+
+/**
+ * restoreSCCs method that makes the SCC labelling stored in a BINARY_SCC_VERSION file the cached SCCs of
+ * G, in O(numVertices). Every index and vertex is checked to be in range and to appear only once
+ *
+ * @param - G - the Digraph loaded from the file
+ * @param - labelling - the SCC labelling in the file
+ * @return - false if the labelling isn't legal (the SCCs are left to be forgotten)
+ */
+static bool restoreSCCs(Digraph G, const int32_t* labelling) {
+  int n = G->numVertices;
+  int numSCCs = labelling[0];
+  int numFree = labelling[1];
+  const int32_t* order = labelling + 2;
+  const int32_t* sizes = order + numSCCs;
+  const int32_t* members = sizes + numSCCs;
+  const int32_t* unused = members + n;
+
+  Workspace W = useWorkspace(G);
+  int stamp = nextStamp(W); // the SCC indices and vertices already seen are stamped
+  allocateComponents(G);
+  if (G->componentOrder == NULL) {
+    G->componentOrder = newOrderList(n);
+    G->freeComponents = malloc(sizeof(int) * n);
+  }
+  clearOrder(G->componentOrder);
+  int at = 0; // the number of vertices placed so far
+  for (int r = 0; r < numSCCs; r++) { // the SCCs in topological order
+    int c = order[r];
+    if (c < 0 || c >= n || W->forwardStamps[c] == stamp || sizes[r] < 1 || sizes[r] > n - at) {
+      return false;
+    }
+    W->forwardStamps[c] = stamp;
+    G->componentSizes[c] = sizes[r];
+    placeLast(G->componentOrder, c);
+    for (int k = 0; k < sizes[r]; k++, at++) {
+      int x = members[at];
+      if (x < 0 || x >= n || W->vertexStamps[x] == stamp) {
+        return false;
+      }
+      W->vertexStamps[x] = stamp;
+      G->componentIds[x] = c;
+      appendMember(G, c, x);
+    }
+  }
+  if (at != n) {
+    return false;
+  }
+  G->numFreeComponents = 0;
+  for (int k = 0; k < numFree; k++) {
+    int c = unused[k];
+    if (c < 0 || c >= n || W->forwardStamps[c] == stamp) {
+      return false;
+    }
+    W->forwardStamps[c] = stamp;
+    G->componentSizes[c] = 0;
+    G->freeComponents[G->numFreeComponents++] = c;
+  }
+  G->numSCCs = numSCCs;
+  G->sccUpdateBudget = SCC_UPDATE_BUDGET * ((long long) n + G->numEdges);
+  G->sccVersion = G->version;
+  return true;
+}
+
+/**
+ * mapBinaryDigraph method that loads a Digraph from a file written by writeBinaryDigraph. The file is
+ * memory-mapped and the edge arrays are used where they are: every NeighborSet with more than NS_INLINE
+ * neighbors borrows its part of the mapping (smaller ones are copied inline), and the mapping also serves
+ * as the Digraph's snapshot. A borrowed list is only copied the first time an edge of that vertex is added
+ * or deleted. The header, the offsets and the targets are all checked first, in one pass over the file,
+ * so a damaged file is rejected instead of being searched. A file written by writeCheckpoint also
+ * restores the SCCs it holds, unless their hash doesn't match, an edge goes back in their topological
+ * order or restoreSCCs finds them illegal; then they are dropped and found again by the next query
+ *
+ * @param - path - the name of the file
+ * @return - the new Digraph, or NULL if the file can't be read or isn't a binary digraph file
+ */
+Digraph mapBinaryDigraph(const char* path) {
+  int fd = open(path, O_RDONLY);
+  if (fd < 0) {
+    return NULL;
+  }
+  struct stat info;
+  void* mapping = MAP_FAILED;
+  if (fstat(fd, &info) == 0 && (size_t) info.st_size >= sizeof(BinaryHeader)) {
+    mapping = mmap(NULL, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  }
+  close(fd); // the mapping stays valid without the descriptor
+  if (mapping == MAP_FAILED) {
+    return NULL;
+  }
+
+  const BinaryHeader* header = mapping;
+  size_t size = info.st_size;
+  int n = header->numVertices;
+  size_t m = header->numEdges;
+  BinaryLayout L = binaryLayout(n > 0 ? n : 0, m);
+  char* base = mapping;
+  bool hashed = header->formatVersion == BINARY_SCC_VERSION;
+  bool withSCCs = hashed || header->formatVersion == BINARY_UNHASHED_SCC_VERSION;
+  bool ok = memcmp(header->magic, BINARY_MAGIC, sizeof(header->magic)) == 0
+      && (header->formatVersion == BINARY_FORMAT_VERSION || withSCCs) && header->byteOrder == BINARY_BYTE_ORDER
+      && sizeof(size_t) == sizeof(uint64_t) && n > 0 && n < INT_MAX && m <= size / sizeof(int32_t);
+  const int32_t* labelling = NULL; // the stored SCCs, while they can still be trusted
+  if (ok && withSCCs) { // the labelling follows the edges
+    size_t labellingSize = L.size <= size ? sccLabellingSize(base, L.scc, size, n, hashed) : 0;
+    L.size += labellingSize;
+    ok = labellingSize > 0;
+    if (ok && L.size == size && hashed && labellingIntact(base, L.scc, labellingSize)) {
+      labelling = (const int32_t*) (base + L.scc);
+    }
+  }
+  ok = ok && L.size == size;
+  size_t* outOffsets = (size_t*) (base + L.outOffsets);
+  int* outTargets = (int*) (base + L.outTargets);
+  size_t* inOffsets = (size_t*) (base + L.inOffsets);
+  int* inTargets = (int*) (base + L.inTargets);
+  int* ranks = labelling != NULL ? labelledRanks(labelling, n) : NULL;
+  bool ordered = ranks != NULL; // whether every edge keeps to the topological order of the labelling
+  ok = ok && validOffsets(outOffsets, n, m) && validOffsets(inOffsets, n, m)
+      && validTargets(outOffsets, outTargets, inOffsets, inTargets, n, ranks, &ordered);
+  free(ranks);
+  if (!ok) {
+    munmap(mapping, size);
+    return NULL;
+  }
+
+  Digraph G = newDigraph(n);
+  for (int i = 0; i < n; i++) { // point every set at its part of the file
+    borrowSortedNeighbors(&G->adjSets[i], outTargets + outOffsets[i], (int) (outOffsets[i + 1] - outOffsets[i]));
+    borrowSortedNeighbors(&G->inSets[i], inTargets + inOffsets[i], (int) (inOffsets[i + 1] - inOffsets[i]));
+  }
+  G->numEdges = (long long) m;
+  G->mapping = mapping;
+  G->mappingSize = size;
+  G->snapshot = borrowSnapshot(n, m, outOffsets, outTargets, inOffsets, inTargets);
+  G->snapshotVersion = G->version;
+  if (ordered && !restoreSCCs(G, labelling)) {
+    forgetSCCs(G); // the next query finds them again
+  }
+  return G;
 }
@@ -6,7 +6,9 @@
 #define _INTEGER_DIGRAPH_H_INCLUDE_
 
 #include <stdio.h>
-#include "List.h"
+#include "Condensation.h"
+#include "Snapshot.h"
+#include "Writer.h"
 
 #define UNVISITED 0
 #define INPROGRESS 1
@@ -23,6 +25,19 @@ Digraph newDigraph(int numVertices);
 // Returns a Digraph that points to a newly created DigraphObj representing a digraph which has
 // n vertices and no edges.
 
+Digraph newDigraphFromEdges(int numVertices, const int* us, const int* vs, size_t m);
+// Returns a Digraph with numVertices vertices and the m edges (us[i], vs[i]), the same graph as
+// calling addEdge for each of them on newDigraph(numVertices), but built in O(numVertices + m)
+// with counting sorts. Duplicate edges are dropped and illegal edges are skipped.
+
+Digraph mapBinaryDigraph(const char* path);
+// Returns a Digraph loaded from a binary file written by writeBinaryDigraph or writeCheckpoint, or
+// NULL if the file can't be read or isn't in that format. The file is memory-mapped and its edge
+// arrays are used in place rather than copied (lists of up to NS_INLINE neighbors excepted); the
+// targets are checked in one O(numVertices + numEdges) pass, so a damaged file is rejected. The
+// SCCs in a checkpoint are restored as the cached SCCs in O(numVertices); if their checksum fails or
+// an edge goes back in their topological order, they are dropped and found again instead.
+
 void freeDigraph(Digraph* pG);
 // Frees all dynamic memory associated with its Digraph* argument, and sets
 // *pG to NULL.
@@ -34,16 +49,23 @@ void clearDigraph(Digraph G);
 int getOrder(Digraph G);
 // Returns the order of G, the number of vertices in G.
 
-int getSize(Digraph G);
+long long getSize(Digraph G);
 // Returns the size of G, the number of edges in G.
 
 int getOutDegree(Digraph G, int u);
 // Returns the number of outgoing neighbors that vertex u has in G, the number of vertices v such
 // that (u, v) is an edge in G. Returns -1 if v is not a legal vertex.
 
-List getNeighbors(Digraph G, int u);
-// Returns a list that has all the vertices that are outgoing neighbors of vertex u, i.e.,
-// a list that has all the vertices v such that (u, v) is an edge in G.
+int getInDegree(Digraph G, int u);
+// Returns the number of incoming neighbors that vertex u has in G, the number of vertices v such
+// that (v, u) is an edge in G.
+
+const int* getNeighbors(Digraph G, int u);
+// Returns an array that has all the vertices that are outgoing neighbors of vertex u, i.e.,
+// all the vertices v such that (u, v) is an edge in G, in ascending order. The array has
+// getOutDegree(G, u) entries, holds 0-based vertices (v - 1), and stays valid until the next
+// addEdge or deleteEdge on u. While G is packed it is decoded into scratch space, so it is only
+// valid until the next call that reads G's edges.
 // There is no input operation that corresponds to getNeighbors.
 
 /*** Manipulation procedures ***/
@@ -62,16 +84,42 @@ int deleteEdge(Digraph G, int u, int v);
 // Returns 1 if (u, v) is a legal edge and the edge didn’t already exist.
 // Returns -1 if (u, v) is not a legal edge.
 
-/*** Other operations ***/
+void packDigraph(Digraph G);
+// Compresses G's edges into a read-only Packed (gap encoded stream-VByte lists, see Packed.h) and
+// frees its NeighborSets and snapshot. Every query works on a packed G; getCountSCC searches the
+// compressed lists in place with the sequential algorithm. The first addEdge or deleteEdge decodes
+// the lists back into NeighborSets, and G stays unpacked until packDigraph is called again.
 
-int DFS(Digraph G, int u, int t);
+/*** Other operations ***/
 
 void printDigraph(FILE* out, Digraph G);
 // Outputs the digraph G in the same format as an input line, including the number of vertices
 // and the edges. The edges should be in sorted order, as described above.
 
+void writeDigraph(Writer W, Digraph G);
+// Same as printDigraph, but writes through the buffered Writer W.
+
+int writeBinaryDigraph(FILE* out, Digraph G);
+// Writes G to out in a compact binary format: a header, then the CSR arrays of freezeDigraph(G).
+// Returns 0 on success and -1 if writing failed.
+
+int writeCheckpoint(FILE* out, Digraph G);
+// Same as writeBinaryDigraph, followed by the SCCs of G (found first if they aren't cached) and
+// their topological order, so that mapBinaryDigraph can restore them instead of finding them again.
+
+Snapshot freezeDigraph(Digraph G);
+// Returns an immutable compressed sparse row copy of G's edges (with the transpose), for fast
+// read-only traversal. The copy is cached and only rebuilt by the first freeze after an addEdge or
+// deleteEdge changes G, and it stays valid until then. G owns it, so it must not be freed.
+
 int getCountSCC(Digraph G);
 // Returns the number of Strongly Connected Components in G.
+void setSCCThreads(Digraph G, int numThreads);
+// Makes getCountSCC find the Strongly Connected Components with numThreads threads. The SCCs are
+// the same for any number of threads; 1 (the default) uses the sequential algorithm.
+void forgetSCCs(Digraph G);
+// Drops the cached SCCs, so that a run of addEdge and deleteEdge calls doesn't keep them up to date
+// one edge at a time; the next query finds them again.
 int getNumSCCVertices(Digraph G, int u);
 // Returns the number of vertices (including u) that are in the same Strongly Connected Component
 // as u in G.. Returns -1 if u is not a legal vertex.
@@ -80,5 +128,31 @@ int inSameSCC (Digraph G, int u, int v);
 // are not in the same Strongly Connected Component of the current digraph.
 // A vertex is always in the same Strongly Connected Component as itself.
 // Returns -1 if u is not a legal vertex.
+void inSameSCCBatch(Digraph G, const int* us, const int* vs, int* results, int n);
+// Stores inSameSCC(G, us[i], vs[i]) in results[i] for each of the n pairs, answering all of them
+// from a single SCC labelling of G.
+Condensation condenseDigraph(Digraph G);
+// Returns the condensation DAG of G: the SCC of each vertex, the size of each SCC and the edges
+// between SCCs in CSR form, with the SCCs numbered in topological order. It is cached like
+// freezeDigraph's Snapshot: built in O(V + E) by the first call after G changes, valid until then,
+// and owned by G, so it must not be freed.
+long long getCondensationSize(Digraph G);
+// Returns the number of edges of the condensation of G, the number of pairs of different SCCs
+// with at least one edge going from the first to the second.
+int getTopoRank(Digraph G, int u);
+// Returns the position (1 .. getCountSCC(G)) of the SCC that u is in, in a topological order of
+// the SCCs: every edge between two SCCs goes from a lower rank to a higher one. Returns -1 if u is
+// not a legal vertex.
+int canReach(Digraph G, int u, int v);
+// Returns 1 if there is a path from u to v in G, and 0 if there isn't. A vertex can always reach
+// itself. Returns -1 if u or v is not a legal vertex. The answer comes from a ReachIndex over the
+// condensation of G, which is rebuilt by the first canReach after G changes.
+int getReachableCount(Digraph G, int u);
+// Returns the number of vertices (including u) that u can reach in G. Returns -1 if u is not a legal
+// vertex.
+void setClosureLimit(Digraph G, size_t bytes);
+// Makes canReach and getReachableCount answer from a bitset transitive closure of the condensation
+// of G whenever it fits in bytes bytes, which makes every query O(1) after a build of about
+// numSCCs * (numSCCs + condensation edges) / 64 word operations. 0 (the default) never builds one.
 
 #endif
@@ -0,0 +1,455 @@
+/************************************************************
+ * DigraphBench.c
+ * Tyler Hoang
+ * Builds synthetic digraphs, times every operation of the Digraph ADT on them, and prints the
+ * throughput, latency percentiles and peak memory use as JSON
+ ************************************************************/
+#define _POSIX_C_SOURCE 200809L // for clock_gettime
+#include "Digraph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <time.h>
+#include <sys/resource.h>
+
+#define NUMGENERATORS 6
+#define COLD_RUNS 5 // the number of from-scratch SCC computations timed for each graph
+#define PRINT_RUNS 5 // the number of times the whole digraph is printed for each graph
+
+static const char* GENERATORS[NUMGENERATORS] = { "er", "rmat", "chain", "cycle", "grid", "tiny" };
+
+/**
+ * EdgeList typedef struct that holds the edges a generator made, as 1-based vertices
+ */
+typedef struct EdgeList {
+  int numVertices;
+  int* us;
+  int* vs;
+  size_t count;
+  size_t capacity;
+} EdgeList;
+
+/**
+ * OpTimes typedef struct that holds the latency of every timed call of one operation
+ */
+typedef struct OpTimes {
+  const char* name;
+  long long* nanos;
+  int count;
+  long long total; // the sum of nanos
+} OpTimes;
+
+static uint64_t rngState; // the state of the xorshift generator, so every run with a seed is the same
+
+/**
+ * nextRandom method that returns the next number from a xorshift64* generator
+ */
+static uint64_t nextRandom(void) {
+  rngState ^= rngState >> 12;
+  rngState ^= rngState << 25;
+  rngState ^= rngState >> 27;
+  return rngState * 2685821657736338717ULL;
+}
+
+/**
+ * randomVertex method that returns a vertex from 1 to n
+ */
+static int randomVertex(int n) {
+  return (int) (nextRandom() % (uint64_t) n) + 1;
+}
+
+/**
+ * nowNanos method that returns the time of a monotonic clock in nanoseconds
+ */
+static long long nowNanos(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (long long) t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+/**
+ * peakRSS method that returns the most memory the process has had resident so far, in kilobytes
+ */
+static long peakRSS(void) {
+  struct rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_maxrss;
+}
+
+/**
+ * pushEdge method that adds the edge (u, v) to the EdgeList, growing it if needed
+ */
+static void pushEdge(EdgeList* E, int u, int v) {
+  if (E->count == E->capacity) {
+    E->capacity = E->capacity == 0 ? 1024 : E->capacity * 2;
+    E->us = realloc(E->us, sizeof(int) * E->capacity);
+    E->vs = realloc(E->vs, sizeof(int) * E->capacity);
+  }
+  E->us[E->count] = u;
+  E->vs[E->count] = v;
+  E->count++;
+}
+
+/**
+ * generate method that fills E with a digraph from the named generator
+ *
+ * @param - E - the empty EdgeList
+ * @param - name - er, rmat, chain, cycle, grid or tiny
+ * @param - n - the number of vertices (grid rounds it down to a square)
+ * @param - degree - the average out degree of er, rmat and tiny
+ */
+static void generate(EdgeList* E, const char* name, int n, int degree) {
+  size_t m = (size_t) n * degree;
+  E->numVertices = n;
+  if (strcmp(name, "er") == 0) { // Erdős–Rényi: m edges between uniformly random vertices
+    for (size_t i = 0; i < m; i++) {
+      int u = randomVertex(n), v = randomVertex(n);
+      if (u != v) {
+        pushEdge(E, u, v);
+      }
+    }
+  }
+  else if (strcmp(name, "rmat") == 0) { // R-MAT with the Graph500 quadrant odds, a power-law graph
+    int scale = 0;
+    while ((1LL << scale) < n) {
+      scale++;
+    }
+    for (size_t i = 0; i < m; i++) {
+      long long u = 0, v = 0;
+      for (int bit = 0; bit < scale; bit++) {
+        uint64_t r = nextRandom() % 100;
+        int down = r >= 57 + 19; // quadrants c and d
+        int right = (r >= 57 && r < 57 + 19) || r >= 57 + 19 + 19; // quadrants b and d
+        u = (u << 1) | down;
+        v = (v << 1) | right;
+      }
+      if (u < n && v < n && u != v) {
+        pushEdge(E, (int) u + 1, (int) v + 1);
+      }
+    }
+  }
+  else if (strcmp(name, "chain") == 0) { // 1 -> 2 -> ... -> n, every vertex its own SCC
+    for (int u = 1; u < n; u++) {
+      pushEdge(E, u, u + 1);
+    }
+  }
+  else if (strcmp(name, "cycle") == 0) { // the chain closed into one giant SCC
+    for (int u = 1; u < n; u++) {
+      pushEdge(E, u, u + 1);
+    }
+    if (n > 1) {
+      pushEdge(E, n, 1);
+    }
+  }
+  else if (strcmp(name, "grid") == 0) { // a side x side grid with edges to the right and down
+    int side = 1;
+    while ((long long) (side + 1) * (side + 1) <= n) {
+      side++;
+    }
+    E->numVertices = side * side;
+    for (int r = 0; r < side; r++) {
+      for (int c = 0; c < side; c++) {
+        int u = r * side + c + 1;
+        if (c + 1 < side) {
+          pushEdge(E, u, u + 1);
+        }
+        if (r + 1 < side) {
+          pushEdge(E, u, u + side);
+        }
+      }
+    }
+  }
+  else { // tiny: cycles of 3 vertices, with random edges from earlier cycles to later ones
+    for (int u = 1; u <= n; u++) {
+      int first = u - (u - 1) % 3;
+      int next = u + 1 <= n && u + 1 < first + 3 ? u + 1 : first;
+      if (next != u) {
+        pushEdge(E, u, next);
+      }
+    }
+    for (size_t i = E->count; i < m; i++) {
+      int u = randomVertex(n), v = randomVertex(n);
+      if ((u - 1) / 3 < (v - 1) / 3) {
+        pushEdge(E, u, v);
+      }
+      else if ((v - 1) / 3 < (u - 1) / 3) {
+        pushEdge(E, v, u);
+      }
+    }
+  }
+}
+
+/**
+ * newOpTimes method that returns room for the latencies of count calls of the named operation
+ */
+static OpTimes newOpTimes(const char* name, int count) {
+  OpTimes T;
+  T.name = name;
+  T.nanos = malloc(sizeof(long long) * (count + 1));
+  T.count = 0;
+  T.total = 0;
+  return T;
+}
+
+/**
+ * record method that stores the latency of one call
+ */
+static void record(OpTimes* T, long long start, long long end) {
+  T->nanos[T->count++] = end - start;
+  T->total += end - start;
+}
+
+/**
+ * compareNanos method used by qsort to sort latencies
+ */
+static int compareNanos(const void* a, const void* b) {
+  long long x = *(const long long*) a;
+  long long y = *(const long long*) b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * percentile method that returns the latency that p percent of the sorted calls are at or under
+ */
+static long long percentile(const OpTimes* T, double p) {
+  int i = (int) (p / 100.0 * T->count + 0.999999) - 1; // nearest rank
+  if (i < 0) {
+    i = 0;
+  }
+  return T->nanos[i];
+}
+
+/**
+ * printOpTimes method that prints the JSON object for one operation and frees its latencies
+ *
+ * @param - T - the latencies
+ * @param - last - whether this is the last operation of the graph (no comma after it)
+ */
+static void printOpTimes(OpTimes* T, bool last) {
+  qsort(T->nanos, T->count, sizeof(long long), compareNanos);
+  double seconds = T->total / 1e9;
+  printf("        {\"op\": \"%s\", \"count\": %d, \"ops_per_sec\": %.1f, \"mean_ns\": %lld, "
+      "\"p50_ns\": %lld, \"p90_ns\": %lld, \"p99_ns\": %lld, \"max_ns\": %lld}%s\n",
+      T->name, T->count, seconds > 0 ? T->count / seconds : 0.0,
+      T->count > 0 ? T->total / T->count : 0,
+      T->count > 0 ? percentile(T, 50) : 0, T->count > 0 ? percentile(T, 90) : 0,
+      T->count > 0 ? percentile(T, 99) : 0, T->count > 0 ? T->nanos[T->count - 1] : 0,
+      last ? "" : ",");
+  free(T->nanos);
+}
+
+/**
+ * benchGraph method that builds one generated digraph, times every operation on it and prints the
+ * results as one JSON object
+ *
+ * @param - name - the generator
+ * @param - n - the number of vertices
+ * @param - degree - the average out degree
+ * @param - ops - the number of calls of each cheap operation
+ * @param - threads - the number of threads getCountSCC uses
+ * @param - last - whether this is the last graph (no comma after it)
+ */
+static void benchGraph(const char* name, int n, int degree, int ops, int threads, bool last) {
+  EdgeList E = { 0, NULL, NULL, 0, 0 };
+  generate(&E, name, n, degree);
+  n = E.numVertices;
+
+  long long start = nowNanos();
+  Digraph G = newDigraphFromEdges(n, E.us, E.vs, E.count);
+  long long built = nowNanos();
+  setSCCThreads(G, threads);
+
+  // GetCountSCC from scratch, on copies that have never had their SCCs found
+  OpTimes cold = newOpTimes("GetCountSCC_cold", COLD_RUNS);
+  int numSCCs = 0;
+  for (int i = 0; i < COLD_RUNS; i++) {
+    Digraph H = newDigraphFromEdges(n, E.us, E.vs, E.count);
+    setSCCThreads(H, threads);
+    long long t = nowNanos();
+    numSCCs = getCountSCC(H);
+    record(&cold, t, nowNanos());
+    freeDigraph(&H);
+  }
+  getCountSCC(G);
+
+  int* us = malloc(sizeof(int) * ops);
+  int* vs = malloc(sizeof(int) * ops);
+  for (int i = 0; i < ops; i++) {
+    us[i] = randomVertex(n);
+    vs[i] = randomVertex(n);
+  }
+
+  OpTimes outDegree = newOpTimes("GetOutDegree", ops);
+  for (int i = 0; i < ops; i++) {
+    long long t = nowNanos();
+    getOutDegree(G, us[i]);
+    record(&outDegree, t, nowNanos());
+  }
+
+  OpTimes countSCC = newOpTimes("GetCountSCC", ops);
+  for (int i = 0; i < ops; i++) {
+    long long t = nowNanos();
+    getCountSCC(G);
+    record(&countSCC, t, nowNanos());
+  }
+
+  OpTimes numSCCVertices = newOpTimes("GetNumSCCVertices", ops);
+  for (int i = 0; i < ops; i++) {
+    long long t = nowNanos();
+    getNumSCCVertices(G, us[i]);
+    record(&numSCCVertices, t, nowNanos());
+  }
+
+  OpTimes sameSCC = newOpTimes("InSameSCC", ops);
+  for (int i = 0; i < ops; i++) {
+    long long t = nowNanos();
+    inSameSCC(G, us[i], vs[i]);
+    record(&sameSCC, t, nowNanos());
+  }
+
+  // AddEdge random edges while the SCCs are kept up to date, then DeleteEdge the new ones again
+  OpTimes add = newOpTimes("AddEdge", ops);
+  bool* added = calloc(ops, sizeof(bool));
+  for (int i = 0; i < ops; i++) {
+    if (us[i] == vs[i]) {
+      continue;
+    }
+    long long t = nowNanos();
+    added[i] = addEdge(G, us[i], vs[i]) == 0;
+    record(&add, t, nowNanos());
+    getCountSCC(G); // a query after every change, so a lazy engine can't put the work off
+  }
+
+  OpTimes del = newOpTimes("DeleteEdge", ops);
+  for (int i = ops - 1; i >= 0; i--) {
+    if (!added[i]) {
+      continue;
+    }
+    long long t = nowNanos();
+    deleteEdge(G, us[i], vs[i]);
+    record(&del, t, nowNanos());
+    getCountSCC(G);
+  }
+
+  OpTimes print = newOpTimes("PrintDigraph", PRINT_RUNS);
+  FILE* sink = fopen("/dev/null", "w");
+  if (sink != NULL) {
+    Writer W = newWriter(sink, 0);
+    for (int i = 0; i < PRINT_RUNS; i++) {
+      long long t = nowNanos();
+      writeDigraph(W, G);
+      flushWriter(W);
+      record(&print, t, nowNanos());
+    }
+    freeWriter(&W);
+    fclose(sink);
+  }
+
+  printf("    {\"generator\": \"%s\", \"vertices\": %d, \"edges\": %lld, \"sccs\": %d, "
+      "\"build_ns\": %lld, \"threads\": %d,\n", name, n, getSize(G), numSCCs, built - start, threads);
+  printf("      \"operations\": [\n");
+  printOpTimes(&cold, false);
+  printOpTimes(&outDegree, false);
+  printOpTimes(&countSCC, false);
+  printOpTimes(&numSCCVertices, false);
+  printOpTimes(&sameSCC, false);
+  printOpTimes(&add, false);
+  printOpTimes(&del, false);
+  printOpTimes(&print, true);
+  printf("      ],\n");
+  printf("      \"peak_rss_kb\": %ld}%s\n", peakRSS(), last ? "" : ",");
+  fflush(stdout);
+
+  free(added);
+  free(us);
+  free(vs);
+  freeDigraph(&G);
+  free(E.us);
+  free(E.vs);
+}
+
+/**
+ * intOption method that reads the value of a numeric option, or returns -1 if it is missing or
+ * out of range
+ */
+static long intOption(int argc, char* argv[], int i, long low, long high) {
+  if (i >= argc) {
+    return -1;
+  }
+  char* end;
+  long value = strtol(argv[i], &end, 10);
+  if (end == argv[i] || *end != '\0' || value < low || value > high) {
+    return -1;
+  }
+  return value;
+}
+
+int main(int argc, char* argv[]) {
+  const char* only = NULL; // set by --graph to run one generator
+  long n = 100000; // set by --vertices
+  long degree = 4; // set by --degree
+  long ops = 1000; // set by --ops
+  long threads = 1; // set by --threads
+  long seed = 1; // set by --seed
+  bool bad = false;
+
+  for (int i = 1; i < argc && !bad; i++) {
+    if (strcmp(argv[i], "--graph") == 0 && i + 1 < argc) {
+      only = argv[++i];
+      bool known = strcmp(only, "all") == 0;
+      for (int g = 0; g < NUMGENERATORS; g++) {
+        known = known || strcmp(only, GENERATORS[g]) == 0;
+      }
+      bad = !known;
+    }
+    else if (strcmp(argv[i], "--vertices") == 0) {
+      bad = (n = intOption(argc, argv, ++i, 1, 1 << 30)) < 0;
+    }
+    else if (strcmp(argv[i], "--degree") == 0) {
+      bad = (degree = intOption(argc, argv, ++i, 0, 1000)) < 0;
+    }
+    else if (strcmp(argv[i], "--ops") == 0) {
+      bad = (ops = intOption(argc, argv, ++i, 1, 100000000)) < 0;
+    }
+    else if (strcmp(argv[i], "--threads") == 0) {
+      bad = (threads = intOption(argc, argv, ++i, 1, 1024)) < 0;
+    }
+    else if (strcmp(argv[i], "--seed") == 0) {
+      bad = (seed = intOption(argc, argv, ++i, 0, 2147483647)) < 0;
+    }
+    else {
+      bad = true;
+    }
+  }
+  if (bad || n * degree > 2147483647) {
+    printf("Usage: %s [--graph er|rmat|chain|cycle|grid|tiny|all] [--vertices N] [--degree D] "
+        "[--ops K] [--threads T] [--seed S]\n", argv[0]);
+    exit(EXIT_FAILURE);
+  }
+  if (only != NULL && strcmp(only, "all") == 0) {
+    only = NULL;
+  }
+
+  printf("{\"vertices\": %ld, \"degree\": %ld, \"ops\": %ld, \"seed\": %ld,\n", n, degree, ops, seed);
+  printf("  \"graphs\": [\n");
+  int lastGenerator = NUMGENERATORS - 1;
+  for (int g = 0; g < NUMGENERATORS; g++) {
+    if (only == NULL || strcmp(only, GENERATORS[g]) == 0) {
+      lastGenerator = g;
+    }
+  }
+  for (int g = 0; g < NUMGENERATORS; g++) {
+    if (only != NULL && strcmp(only, GENERATORS[g]) != 0) {
+      continue;
+    }
+    rngState = 0x9E3779B97F4A7C15ULL ^ ((uint64_t) seed * 0xBF58476D1CE4E5B9ULL + g);
+    if (rngState == 0) { // xorshift would only ever return 0
+      rngState = 1;
+    }
+    benchGraph(GENERATORS[g], (int) n, (int) degree, (int) ops, (int) threads, g == lastGenerator);
+  }
+  printf("  ]}\n");
+  return (EXIT_SUCCESS);
+}
@@ -5,479 +5,953 @@
  * properties of the Digraph based on the next input lines
  ************************************************************/
 #include "Digraph.h"
+#include "Journal.h"
+#include "Scanner.h"
+#include "Server.h"
+#include "Stats.h"
+#include <limits.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <stdbool.h>
 
-#define MAX 999999 //used to set the max size of the input line
+#define IS_DIGIT(c) ((c) >= '0' && (c) <= '9')
+#define MAX_VERTICES (INT_MAX - 1) // vertex ids are 32-bit and numVertices + 1 has to fit in an int too
+#define ACCUMULATE_DIGIT(value, c) ((value) > INT_MAX ? (value) : (value) * 10 + ((c) - '0')) // adds a digit
+// to value, stopping once it is past INT_MAX so that no run of digits can overflow it
+
+/**
+ * FirstLine typedef struct that keeps the bytes of the first line read so far when the input file can't be
+ * read again (such as a pipe), so that an illegal first line can still be echoed
+ */
+typedef struct FirstLine {
+  Scanner S; // the Scanner the line is read from
+  bool keep; // whether the bytes are kept (only if the input isn't seekable)
+  char* bytes; // the bytes read so far
+  size_t length; // the number of bytes in bytes
+  size_t capacity; // the number of bytes bytes has room for
+} FirstLine;
+
+/**
+ * nextChar method that returns the next byte of the first line from its Scanner, keeping it if it has to be
+ */
+static int nextChar(FirstLine* L) {
+  int c = scanChar(L->S);
+  if (L->keep && c != EOF) {
+    if (L->length == L->capacity) {
+      L->capacity = L->capacity == 0 ? 4096 : L->capacity * 2;
+      L->bytes = realloc(L->bytes, L->capacity);
+    }
+    L->bytes[L->length++] = (char) c;
+  }
+  return c;
+}
 
-int main (int argc, char* argv[]) {
-  FILE* out;
-  FILE* in;
-  char line[MAX]; // char array to store words from input file
-  
-  // check command line for correct number of arguments
-  if( argc != 3 ){
-    printf("Usage: %s <input file> <output file>\n", argv[0]);
-    exit(EXIT_FAILURE);
+/**
+ * echoFirstLine method that copies the first line of the input file to out. A seekable file is read again
+ * from the start of the line, so that a first line of any length can be echoed without being kept in memory;
+ * otherwise the bytes kept so far are written and the rest of the line is read from the Scanner
+ *
+ * @param - L - the FirstLine being read
+ * @param - in - the input file
+ * @param - start - the position of the first line in the input file (-1 if it can't be read again)
+ * @param - out - the Writer for the output file
+ */
+static void echoFirstLine(FirstLine* L, FILE* in, long start, Writer out) {
+  int c;
+  if (L->keep) {
+    writeChars(out, L->bytes, L->length);
+    if (L->length > 0 && L->bytes[L->length - 1] == '\n') {
+      return;
+    }
+    while ((c = scanChar(L->S)) != EOF) {
+      writeChar(out, (char) c);
+      if (c == '\n') {
+        break;
+      }
+    }
+    return;
   }
-  
-  // open input file for reading
-  in = fopen(argv[1], "r");
-  if( in==NULL ){
-    printf("Unable to read from file %s\n", argv[1]);
-    exit(EXIT_FAILURE);
+  if (fseek(in, start, SEEK_SET) != 0) { // the input can't be read again after all
+    return;
   }
-  
-  // open output file for writing
-  out = fopen (argv[2], "w");
-  if( out==NULL ){
-    printf("Unable to write to file %s\n", argv[2]);
-    exit(EXIT_FAILURE);
+  while ((c = getc(in)) != EOF) {
+    writeChar(out, (char) c);
+    if (c == '\n') {
+      break;
+    }
   }
+}
 
-  fgets(line, MAX, in); // get the first line of the input file
-  int i = 0; // used to iterate through the input line
-  int p = 0; // used later to mark where the first comma in the line is
-  int value = 0; // will be used when the number is converted to an int
-  char number = *(line); // set number to be the first digit in the line
-  
-  while (((int) number < 58) && ((int) number > 47)) { // until p encounters a comma                         
-    value = value * 10 + (number - 48); // convert the digit to an int and add it to the existing value      
-    p++; // increment p                                                                                      
-    number = *(line + p); // move onto the next digit                                                    
-  }  
-  
-  int vertices = value; //set numVertices to value
-  if (vertices == 0) {
-    fprintf(out, "%s", line);
-    fprintf(out, "ERROR\n");
-    fclose(in);
-    fclose(out);
-    return (EXIT_SUCCESS);
+/**
+ * readDigraph method that reads the first line of the input ("numVertices, u v, u v, ...") in a single
+ * streaming pass and builds the Digraph it describes. The line can be any length. If the line is an error,
+ * it is echoed to out followed by ERROR and NULL is returned
+ *
+ * @param - S - the Scanner positioned at the start of the first line
+ * @param - in - the input file the Scanner reads from
+ * @param - start - the position of the first line in the input file (-1 if it can't be read again)
+ * @param - out - the Writer for the output file
+ * @return - the new Digraph, or NULL if the first line is an error
+ */
+static Digraph readDigraph(Scanner S, FILE* in, long start, Writer out) {
+  FirstLine line = {S, start < 0, NULL, 0, 0}; // a pipe can't be read again, so its first line is kept
+  long long value = 0; // will be used when the number is converted to an int
+  int number = nextChar(&line); // set number to be the first digit in the line
+
+  while (IS_DIGIT(number)) { // until a comma is encountered
+    value = ACCUMULATE_DIGIT(value, number); // convert the digit to an int and add it to the existing value
+    number = nextChar(&line); // move onto the next digit
+  }
+
+  if (value == 0 || value > MAX_VERTICES) { // vertex ids are 32-bit, so larger orders can't be stored
+    echoFirstLine(&line, in, start, out);
+    writeString(out, "ERROR\n");
+    free(line.bytes);
+    return NULL;
   }
+  int vertices = (int) value; //set numVertices to value
 
-  value = 0; // reset value to be used for the next digit
-  Digraph myDigraph = newDigraph(vertices); // create a new Digraph object with numVertices
+  size_t numEdges = 0; // the number of edges read from the first line so far
+  size_t edgeCapacity = 1024; // the number of edges us and vs have room for
+  int* us = malloc(sizeof(int) * edgeCapacity); // the starting vertex of each edge
+  int* vs = malloc(sizeof(int) * edgeCapacity); // the ending vertex of each edge
 
   bool newSet = true; // will be used after each comma is encountered to signify a new set of vertices
   int adjListsLocation = 0; // will later be used as vertex u
   int neighborToBeAdded = 0; // will later be used as vertex v
-  
-  while(p + i < strlen(line)) { // iterate through each of the next characters in the first line
-    if (!(((int) number < 58) && ((int) number > 47))) { // if the character is not a digit
-      if ((int) number != 44) { // if the character is not a comma, which means it is a space
-	i++;
-	number = *(line + p + i); // move onto the next digit
-	continue;
+
+  while (number != '\n' && number != EOF) { // iterate through each of the next characters in the first line
+    if (IS_DIGIT(number)) { // if number is between '0' and '9'
+      value = 0;
+      while (IS_DIGIT(number)) { // until a space is encountered
+        value = ACCUMULATE_DIGIT(value, number); // convert the digit to an int and add it to the existing value
+        number = nextChar(&line); // move onto the next digit
       }
-    }
-    
-    value = 0; // reset value after every space
-    if (((int) number < 58) && ((int) number > 47)) { // if number is between '0' and '9' (ASCII values)
-      while (((int) number < 58) && ((int) number > 47)) { // until i encounters a space
-	value = value * 10 + (number - 48); // convert the digit to an int and add it to the existing value
-	i++; // increment i
-	number = *(line + p + i); // move onto the next digit
+      if (value > vertices) { // it can't be a vertex, so keep it from being truncated into one
+        value = 0LL + vertices + 1;
       }
-      
+
       if (newSet) { // if this is a new set of vertices
-	adjListsLocation = value;
-	newSet = false; // this is no longer a new set of vertices
-	continue; // move onto the next digit
+        adjListsLocation = (int) value;
+        newSet = false; // this is no longer a new set of vertices
+        continue; // move onto the next digit
       }
-      
-      if (!newSet) { // while in this current set of vertices
-	neighborToBeAdded = value;
-	if (neighborToBeAdded > getOrder(myDigraph) || adjListsLocation > getOrder(myDigraph)) { // if any input vertices are greater than numVertices
-	  fprintf(out, "%s", line);
-	  fprintf(out, "ERROR\n"); // this Digraph is an error
-	  freeDigraph(&myDigraph);
-	  fclose(in);
-	  fclose(out);
-	  return (EXIT_SUCCESS);
-	}
-
-	addEdge(myDigraph, adjListsLocation, neighborToBeAdded); // add the edge to the Digraph
-	continue; // move onto the next set of vertices
+
+      neighborToBeAdded = (int) value;
+      if (neighborToBeAdded > vertices || adjListsLocation > vertices) { // if any input vertices are greater than numVertices
+        echoFirstLine(&line, in, start, out);
+        writeString(out, "ERROR\n"); // this Digraph is an error
+        free(line.bytes);
+        free(us);
+        free(vs);
+        return NULL;
       }
-    }
-    
-    if ((int) number == 44) { // if the current character is a comma
-      if (adjListsLocation == 0 || neighborToBeAdded == 0) { // if all the program has iterated through was the first digit in the line
-	i++;
-	number = *(line + p + i);
-	newSet = true;
-	continue; // begin iterating through the set of vertices
+
+      if (numEdges == edgeCapacity) { // if us and vs are full, double their size
+        edgeCapacity *= 2;
+        us = realloc(us, sizeof(int) * edgeCapacity);
+        vs = realloc(vs, sizeof(int) * edgeCapacity);
       }
-      
-      newSet = true;
-      value = 0;
-      i++;
-      number = *(line + p + i);
+      us[numEdges] = adjListsLocation; // save the edge, the Digraph is built once the whole line is read
+      vs[numEdges] = neighborToBeAdded;
+      numEdges++;
       continue; // move onto the next set of vertices
     }
+
+    if (number == ',') { // if the current character is a comma, a new set of vertices begins
+      newSet = true;
+    }
+    number = nextChar(&line); // skip commas and spaces
   }
 
-  /////////////////////////////////////////////////////////////////////
-  // Graph has been created
-  /////////////////////////////////////////////////////////////////////
-  
-  // chars that will be used to see input lines have certain keywords
-  const char PRINTDIGRAPH[20] = "PrintDigraph";
-  const char GETORDER[20] = "GetOrder";
-  const char GETSIZE[20] ="GetSize";
-  const char GETOUTDEGREE[20] = "GetOutDegree";
-  const char ADDEDGE[20] = "AddEdge";
-  const char DELETEEDGE[20] = "DeleteEdge";
-  const char GETCOUNTSCC[20] = "GetCountSCC";
-  const char GETNUMSCCVERTICES[20] = "GetNumSCCVertices";
-  const char INSAMESCC[20] = "InSameSCC";
-  
-  while (fgets(line, MAX, in) != NULL) { // while there is a next line in the input file
-    
-    char *printdigraph = strstr(line, PRINTDIGRAPH); // if input line is PrintDigraph
-    char *getorder = strstr(line, GETORDER); // if input line is GetOrder
-    char *getsize = strstr(line, GETSIZE); // if input line is GetSize
-    char *getoutdegree = strstr(line, GETOUTDEGREE); // if input line is GetOutDegree
-    char *addedge = strstr(line, ADDEDGE); // if input line is AddEdge
-    char *deleteedge = strstr(line, DELETEEDGE); // if input line is DeleteEdge
-    char *getcountscc = strstr(line, GETCOUNTSCC); // if input line is GetCountSCC    
-    char *getnumsccvertices = strstr(line, GETNUMSCCVERTICES); // if input line is GetNumSCCVerices
-    char *insamescc = strstr(line, INSAMESCC); // if input line is InSameScc
-
-    if (!printdigraph && !getorder && !getsize && !getoutdegree && !addedge && !deleteedge && !getcountscc && !getnumsccvertices && !insamescc) { // if the input line is an unknown command
-      if (strlen(line) == 1) {
-	continue;
-      }
-      fprintf(out, "%s", line);
-      fprintf(out, "ERROR\n");
+  Digraph G = newDigraphFromEdges(vertices, us, vs, numEdges); // build the Digraph from every edge at once
+  free(line.bytes);
+  free(us);
+  free(vs);
+  return G;
+}
+
+/////////////////////////////////////////////////////////////////////
+// Commands
+/////////////////////////////////////////////////////////////////////
+
+#define COMMAND_TABLE_SIZE 32 // the size of the perfect hash table of keywords
+#define MAX_OPERAND_DIGITS 10 // operands with more digits than this can't be legal vertices
+
+/**
+ * Every command the input lines can contain. They are listed in the order that the
+ * checks for them are applied to a line
+ */
+typedef enum {
+  PRINTDIGRAPH, GETORDER, GETSIZE, GETOUTDEGREE, GETINDEGREE, ADDEDGE, DELETEEDGE,
+  GETCOUNTSCC, GETNUMSCCVERTICES, INSAMESCC, GETCONDENSATIONSIZE, GETTOPORANK, CANREACH,
+  GETREACHABLECOUNT, NUMCOMMANDS
+} CommandType;
+
+/**
+ * CommandInfo typedef struct that describes the keyword of a command and how many vertices follow it
+ */
+typedef struct CommandInfo {
+  const char* keyword;
+  int length; // the length of keyword
+  int operands; // the number of vertices that follow the keyword
+} CommandInfo;
+
+static const CommandInfo COMMANDS[NUMCOMMANDS] = {
+  {"PrintDigraph", 12, 0},
+  {"GetOrder", 8, 0},
+  {"GetSize", 7, 0},
+  {"GetOutDegree", 12, 1},
+  {"GetInDegree", 11, 1},
+  {"AddEdge", 7, 2},
+  {"DeleteEdge", 10, 2},
+  {"GetCountSCC", 11, 0},
+  {"GetNumSCCVertices", 17, 1},
+  {"InSameSCC", 9, 2},
+  {"GetCondensationSize", 19, 0},
+  {"GetTopoRank", 11, 1},
+  {"CanReach", 8, 2},
+  {"GetReachableCount", 17, 1}
+};
+
+static signed char commandTable[COMMAND_TABLE_SIZE]; // maps the hash of a keyword to its CommandType, or -1
+
+/**
+ * keywordHash method that hashes a keyword of at least 3 letters. It is a perfect hash for the keywords in
+ * COMMANDS, so looking up a keyword takes one hash, one table read and one memcmp
+ *
+ * @param - word - the keyword
+ * @param - length - the length of word
+ * @return - the slot of word in commandTable
+ */
+static int keywordHash(const char* word, int length) {
+  return (length + (unsigned char) word[2] + (unsigned char) word[length - 1]) % COMMAND_TABLE_SIZE;
+}
+
+/**
+ * initCommandTable method that fills the perfect hash table of keywords
+ */
+static void initCommandTable(void) {
+  memset(commandTable, -1, sizeof(commandTable));
+  for (int c = 0; c < NUMCOMMANDS; c++) {
+    int slot = keywordHash(COMMANDS[c].keyword, COMMANDS[c].length);
+    if (commandTable[slot] != -1) { // keywordHash has to be changed whenever a new keyword collides
+      fprintf(stderr, "keyword %s collides with %s\n", COMMANDS[c].keyword, COMMANDS[commandTable[slot]].keyword);
+      exit(EXIT_FAILURE);
     }
+    commandTable[slot] = (signed char) c;
+  }
+}
 
-    if (printdigraph) { // if the input line is PrintDigraph
-      if (strlen(line) > 13) { // if there are any characters after PrintDigraph
-	fprintf(out, "%s", line);
-	fprintf(out, "ERROR\n");
-      }
-      
-      else {
-	fprintf(out, "PrintDigraph\n");
-	printDigraph(out, myDigraph);
-      }
+/**
+ * parseCommand method that classifies a line in a single left to right pass. The line is legal if it is
+ * a keyword followed by the right number of vertices, each after a single space, and then a newline
+ *
+ * @param - line - the input line
+ * @param - length - the length of line
+ * @param - order - the number of vertices in the Digraph
+ * @param - u - set to the first vertex, if there is one
+ * @param - v - set to the second vertex, if there is one
+ * @return - the CommandType, or -1 if the line isn't a legal command
+ */
+static int parseCommand(const char* line, size_t length, int order, int* u, int* v) {
+  size_t i = 0;
+  while (i < length && ((line[i] >= 'A' && line[i] <= 'Z') || (line[i] >= 'a' && line[i] <= 'z'))) {
+    i++; // the keyword is the leading run of letters
+  }
+  if (i < 3) {
+    return -1;
+  }
+  int c = commandTable[keywordHash(line, (int) i)];
+  if (c < 0 || COMMANDS[c].length != (int) i || memcmp(line, COMMANDS[c].keyword, i) != 0) {
+    return -1;
+  }
+
+  int* operands[2] = {u, v};
+  for (int k = 0; k < COMMANDS[c].operands; k++) { // read each " <vertex>"
+    if (line[i] != ' ' || !IS_DIGIT(line[i + 1])) {
+      return -1;
     }
-    
-    if (getorder) { // if the input line is GetOrder
-      int order = getOrder(myDigraph);
-      if (strlen(line) > 9) { // if there are any characters after GetOrder
-        fprintf(out, "%s", line);
-        fprintf(out, "ERROR\n");
+    i++;
+    long long value = 0; // 10 digits can be past INT_MAX, so they are read into 64 bits
+    int digits = 0;
+    while (IS_DIGIT(line[i])) {
+      if (++digits > MAX_OPERAND_DIGITS) {
+        return -1;
       }
+      value = value * 10 + (line[i] - '0');
+      i++;
+    }
+    if (value < 1 || value > order) { // if the vertex is not between 1 and numVertices
+      return -1;
+    }
+    *operands[k] = (int) value;
+  }
+  if (i != length - 1 || line[i] != '\n') { // there can't be anything after the operands but the newline
+    return -1;
+  }
+  return c;
+}
+
+/**
+ * legacyOperands method that checks a line against command c with the original fixed position rules: the
+ * operands are read starting one character after where the keyword would end if the line started with it,
+ * wherever the keyword actually appears. Lines that parseCommand rejects are checked this way so that
+ * unusual lines are answered exactly as they always have been
+ *
+ * @param - line - the input line
+ * @param - length - the length of line
+ * @param - c - the CommandType whose keyword appears in line
+ * @param - order - the number of vertices in the Digraph
+ * @param - u - set to the first vertex, if there is one
+ * @param - v - set to the second vertex, if there is one
+ * @return - true if the line is a legal use of command c
+ */
+static bool legacyOperands(const char* line, size_t length, int c, int order, int* u, int* v) {
+  size_t start = COMMANDS[c].length + 1; // where the first operand has to begin
+  if (COMMANDS[c].operands == 0) {
+    return length <= start; // nothing can follow the keyword but the newline
+  }
+  if (start > length || !IS_DIGIT(line[start])) { // if there are no numbers provided
+    return false;
+  }
 
-      else{
-	fprintf(out, "GetOrder\n");
-	fprintf(out, "%d\n", order);
+  size_t k = 0;
+  long long digit = 0;
+  if (COMMANDS[c].operands == 1) {
+    while (IS_DIGIT(line[start + k])) {
+      if (start + k == length - 1) { // once the end of the input line has been reached
+        break;
       }
+      digit = digit * 10 + (line[start + k] - '0');
+      digit = digit > order ? (long long) order + 1 : digit; // anything past numVertices is equally illegal
+      k++;
     }
-    
-    if (getsize) { // if the input line is GetSize
-      int size = getSize(myDigraph);
-      if (strlen(line) > 8) { // if there are any characters after GetSize
-        fprintf(out, "%s", line);
-        fprintf(out, "ERROR\n");
-      }
+    *u = (int) digit;
+    return digit >= 1 && digit <= order && length - 1 <= start + k;
+  }
 
-      else{
-	fprintf(out, "GetSize\n");
-	fprintf(out, "%d\n", size);
-      }
+  while (IS_DIGIT(line[start + k])) { // the first number runs until its first non-digit
+    digit = digit * 10 + (line[start + k] - '0');
+    digit = digit > order ? (long long) order + 1 : digit;
+    k++;
+  }
+  *u = (int) digit;
+  size_t second = start + 1; // the second number begins one character after the first one ends
+  if (second + k > length || !IS_DIGIT(line[second + k])) { // if there is only one number provided
+    return false;
+  }
+  digit = 0;
+  while (IS_DIGIT(line[second + k])) {
+    digit = digit * 10 + (line[second + k] - '0');
+    digit = digit > order ? (long long) order + 1 : digit;
+    k++;
+    if (second + k == length - 1) { // if the end of the input line has been reached
+      break;
     }
+  }
+  *v = (int) digit;
+  return *u >= 1 && *u <= order && digit >= 1 && digit <= order && length <= second + k + 1;
+}
 
-    if (getoutdegree) { // if the input line is getOutDegree
-      int digit = 0; // will be used when the char is converted to an int
-      int k = 0; // used to iterate through the input line
-      char ch = *(line + 13); // set ch to be right after the chars 'getOutDegree'
-      
-      if (!(((int) ch < 58) && ((int) ch > 47))) { // if there is no number provided
-	fprintf(out, "%s", line);
-	fprintf(out, "ERROR\n");
-      }
-      
-      else{ // there is a number provided
-	while (((int) ch < 58) && ((int) ch > 47)) { // until k encounters a space
-	  if (k + 13 == strlen(line) - 1) { // once the end of the input line as been reached
-	    break;
-	  }
-	  digit = digit * 10 + (ch - 48); // convert ch to an int and add it to the existing value of digit
-	  k++; // increment k
-	  ch = *(line + 13 + k); // move onto the next digit
-	}
-	
-	int u = digit; // set u to be the converted int    
-	if (u > getOrder(myDigraph) || u < 1) { // if u is greater than numVertices or less than 1
-	  fprintf(out, "%s", line);
-	  fprintf(out, "ERROR\n");
-	}
-	else if (strlen(line) - 1 > 13 + k) { // if there is an additional number
-	  fprintf(out, "%s", line);
-          fprintf(out, "ERROR\n");
-	}
-	
-	else {
-	  fprintf(out, "GetOutDegree %d\n", u);
-	  fprintf(out, "%d\n", getOutDegree(myDigraph, u));
-	}
-      }
+/**
+ * writeEcho method that writes the echo of a legal command: its keyword and its vertices
+ *
+ * @param - out - the Writer for the output file
+ * @param - c - the CommandType
+ * @param - u - the first vertex, if the command has one
+ * @param - v - the second vertex, if the command has one
+ */
+static void writeEcho(Writer out, int c, int u, int v) {
+  writeChars(out, COMMANDS[c].keyword, COMMANDS[c].length);
+  if (COMMANDS[c].operands >= 1) {
+    writeChar(out, ' ');
+    writeInt(out, u);
+  }
+  if (COMMANDS[c].operands == 2) {
+    writeChar(out, ' ');
+    writeInt(out, v);
+  }
+  writeChar(out, '\n');
+}
+
+/**
+ * executeCommand method that writes a legal command and its result. An AddEdge or DeleteEdge that changes
+ * G is recorded in J
+ *
+ * @param - G - the Digraph
+ * @param - J - the Journal, or NULL if changes aren't recorded
+ * @param - c - the CommandType
+ * @param - u - the first vertex, if the command has one
+ * @param - v - the second vertex, if the command has one
+ * @param - out - the Writer for the output file
+ */
+static void executeCommand(Digraph G, Journal J, int c, int u, int v, Writer out) {
+  writeEcho(out, c, u, v);
+  int result;
+  switch (c) {
+  case PRINTDIGRAPH:
+    writeDigraph(out, G);
+    return;
+  case GETORDER:
+    writeInt(out, getOrder(G));
+    break;
+  case GETSIZE:
+    writeInt(out, getSize(G));
+    break;
+  case GETOUTDEGREE:
+    writeInt(out, getOutDegree(G, u));
+    break;
+  case GETINDEGREE:
+    writeInt(out, getInDegree(G, u));
+    break;
+  case ADDEDGE:
+    result = addEdge(G, u, v);
+    if (result == 0 && J != NULL) { // the edge was added
+      journalEdge(J, true, u, v);
+    }
+    writeInt(out, result);
+    break;
+  case DELETEEDGE:
+    result = deleteEdge(G, u, v);
+    if (result == 0 && J != NULL) { // the edge was deleted
+      journalEdge(J, false, u, v);
+    }
+    writeInt(out, result);
+    break;
+  case GETCOUNTSCC:
+    writeInt(out, getCountSCC(G));
+    break;
+  case GETNUMSCCVERTICES:
+    writeInt(out, getNumSCCVertices(G, u));
+    break;
+  case INSAMESCC:
+    writeString(out, inSameSCC(G, u, v) ? "YES" : "NO");
+    break;
+  case GETCONDENSATIONSIZE:
+    writeInt(out, getCondensationSize(G));
+    break;
+  case GETTOPORANK:
+    writeInt(out, getTopoRank(G, u));
+    break;
+  case CANREACH:
+    writeString(out, canReach(G, u, v) ? "YES" : "NO");
+    break;
+  case GETREACHABLECOUNT:
+    writeInt(out, getReachableCount(G, u));
+    break;
+  }
+  writeChar(out, '\n');
+}
+
+/**
+ * writeError method that echoes an input line followed by ERROR
+ *
+ * @param - out - the Writer for the output file
+ * @param - line - the input line
+ * @param - length - the length of line
+ */
+static void writeError(Writer out, const char* line, size_t length) {
+  writeChars(out, line, length);
+  writeString(out, "ERROR\n");
+}
+
+#define MAX_BATCH 4096 // the most InSameSCC lines that are held back to be answered together
+
+/**
+ * Session typedef struct that holds everything needed to answer the lines of one input
+ */
+typedef struct Session {
+  Digraph G; // the Digraph the commands are applied to
+  Writer out; // the Writer for the output file
+  bool batching; // whether consecutive InSameSCC lines are answered together
+  int pendingCount; // the number of InSameSCC lines waiting to be answered
+  int pendingUs[MAX_BATCH]; // the first vertex of each waiting InSameSCC line
+  int pendingVs[MAX_BATCH]; // the second vertex of each waiting InSameSCC line
+  int pendingResults[MAX_BATCH]; // where the answers are stored
+  LatencyHistogram* latencies; // the latencies of each CommandType, or NULL if --stats is off
+  long long errorLines; // the number of lines answered with ERROR
+  struct Session* server; // with --serve, the Session every client's errorLines are added to when it leaves
+  Journal journal; // where the changes to G are recorded with --journal (NULL otherwise)
+} Session;
+
+/**
+ * runCommand method that executes one command, timing it if --stats is on
+ *
+ * @param - S - the Session
+ * @param - c - the CommandType
+ * @param - u - the first operand, if any
+ * @param - v - the second operand, if any
+ */
+static void runCommand(Session* S, int c, int u, int v) {
+  if (S->latencies == NULL) {
+    executeCommand(S->G, S->journal, c, u, v, S->out);
+    return;
+  }
+  long long start = statsNanos();
+  executeCommand(S->G, S->journal, c, u, v, S->out);
+  recordLatency(&S->latencies[c], statsNanos() - start, 1);
+}
+
+/**
+ * flushPending method that answers the waiting InSameSCC lines with a single inSameSCCBatch call
+ *
+ * @param - S - the Session
+ */
+static void flushPending(Session* S) {
+  if (S->pendingCount == 0) {
+    return;
+  }
+  long long start = S->latencies != NULL ? statsNanos() : 0;
+  inSameSCCBatch(S->G, S->pendingUs, S->pendingVs, S->pendingResults, S->pendingCount);
+  for (int i = 0; i < S->pendingCount; i++) {
+    writeEcho(S->out, INSAMESCC, S->pendingUs[i], S->pendingVs[i]);
+    writeString(S->out, S->pendingResults[i] ? "YES\n" : "NO\n");
+  }
+  if (S->latencies != NULL) { // the batch's time is shared evenly by its lines
+    recordLatency(&S->latencies[INSAMESCC], (statsNanos() - start) / S->pendingCount, S->pendingCount);
+  }
+  S->pendingCount = 0;
+  endCommand(S->out);
+}
+
+/**
+ * processLine method that answers one input line. A legal command is dispatched straight from parseCommand,
+ * except that while batching, legal InSameSCC lines are held back and answered together when the run of
+ * them ends. Any other line is echoed followed by ERROR, once for every keyword it contains (or once if it
+ * has none), unless it is an empty line
+ *
+ * @param - S - the Session
+ * @param - line - the input line
+ * @param - length - the length of line
+ */
+static void processLine(Session* S, const char* line, size_t length) {
+  Digraph G = S->G;
+  Writer out = S->out;
+  int u = 0;
+  int v = 0;
+  int c = parseCommand(line, length, getOrder(G), &u, &v);
+  if (c == INSAMESCC && S->batching) {
+    if (S->pendingCount == MAX_BATCH) {
+      flushPending(S);
+    }
+    S->pendingUs[S->pendingCount] = u;
+    S->pendingVs[S->pendingCount] = v;
+    S->pendingCount++;
+    return;
+  }
+  flushPending(S); // anything else ends the run of InSameSCC lines, which are answered first
+
+  if (c >= 0) {
+    runCommand(S, c, u, v);
+    endCommand(out);
+    return;
+  }
+
+  bool anyKeyword = false;
+  for (c = 0; c < NUMCOMMANDS; c++) { // the rare path: check the line against every keyword it contains
+    if (strstr(line, COMMANDS[c].keyword) == NULL) {
+      continue;
+    }
+    anyKeyword = true;
+    if (legacyOperands(line, length, c, getOrder(G), &u, &v)) {
+      runCommand(S, c, u, v);
+    }
+    else {
+      writeError(out, line, length);
+      S->errorLines++;
     }
+  }
+  if (!anyKeyword && length != 1) { // if the input line is an unknown command
+    writeError(out, line, length);
+    S->errorLines++;
+  }
+  endCommand(out);
+}
+
+/**
+ * openSession method that starts a Session for a client of --serve. Every client shares the Digraph (and
+ * with it the cached SCCs, condensation and reachability index) and the latencies of the server Session
+ *
+ * @param - context - the server Session
+ * @param - out - the Writer for the client's answers
+ * @return - the client's Session
+ */
+static void* openSession(void* context, Writer out) {
+  Session* server = context;
+  Session* S = malloc(sizeof(Session));
+  S->G = server->G;
+  S->out = out;
+  S->batching = server->batching;
+  S->pendingCount = 0;
+  S->latencies = server->latencies;
+  S->errorLines = 0;
+  S->server = server;
+  S->journal = server->journal;
+  return S;
+}
+
+/**
+ * serveLine method that answers a line a client of --serve sent
+ */
+static void serveLine(void* client, const char* line, size_t length) {
+  processLine(client, line, length);
+}
+
+/**
+ * commitChanges method that makes the changes the lines of every client made since the last commit durable
+ * with one journal commit, before any of them is answered. A server that can't record its changes stops
+ *
+ * @param - context - the server Session
+ */
+static void commitChanges(void* context) {
+  Session* server = context;
+  if (server->journal != NULL && commitJournal(server->journal, server->G) != 0) {
+    fprintf(stderr, "Unable to write to the journal\n");
+    exit(EXIT_FAILURE);
+  }
+}
+
+/**
+ * finishLines method that sends a client of --serve every answer it is owed once the lines it has sent so
+ * far are used up, so answers stream back without waiting for more input
+ */
+static void finishLines(void* client) {
+  Session* S = client;
+  flushPending(S);
+  flushWriter(S->out);
+}
+
+/**
+ * closeSession method that ends the Session of a client of --serve
+ */
+static void closeSession(void* client) {
+  Session* S = client;
+  flushPending(S);
+  S->server->errorLines += S->errorLines;
+  free(S);
+}
+
+/**
+ * writeStats method that writes the --stats summary as a single JSON object
+ *
+ * @param - out - the file
+ * @param - S - the Session
+ * @param - counters - the internal work counters
+ * @param - loadNanos - the time spent loading the digraph
+ * @param - totalNanos - the time spent loading the digraph and answering every line
+ */
+static void writeStats(FILE* out, Session* S, StatsCounters* counters, long long loadNanos, long long totalNanos) {
+  fprintf(out, "{\"load_ns\": %lld, \"total_ns\": %lld, \"error_lines\": %lld,\n \"commands\": {",
+      loadNanos, totalNanos, S->errorLines);
+  for (int c = 0; c < NUMCOMMANDS; c++) {
+    fprintf(out, "%s\n  \"%s\": ", c == 0 ? "" : ",", COMMANDS[c].keyword);
+    writeHistogramJSON(out, &S->latencies[c]);
+  }
+  fprintf(out, "},\n \"counters\": ");
+  writeCountersJSON(out, counters);
+  fprintf(out, "}\n");
+}
 
-    if (addedge) { // if the input line is AddEdge
-      bool twoDigits = true; // used to check if the input line includes 2 vertices
-      int digit = 0; // will be used when the char is converted to an int
-      int k = 0; // used to iterate through the input line
-      char ch = *(line + 8); // set ch to be right after the chars 'AddEdge'
-      
-      if (!(((int) ch < 58) && ((int) ch > 47))) { // if there are no numbers provided
-	fprintf(out, "%s", line);
-	fprintf(out, "ERROR\n");
+/**
+ * convertDigraph method that reads the digraph on the first line of a text input file and writes it to
+ * a binary file that --graph can map straight into memory. Errors in the first line are reported on
+ * standard output the same way they would be in the output file
+ *
+ * @param - inPath - the text input file
+ * @param - outPath - the binary file to write
+ * @return - EXIT_SUCCESS or EXIT_FAILURE
+ */
+static int convertDigraph(const char* inPath, const char* outPath) {
+  FILE* in = fopen(inPath, "r");
+  if (in == NULL) {
+    printf("Unable to read from file %s\n", inPath);
+    return EXIT_FAILURE;
+  }
+  Writer writer = newWriter(stdout, 1);
+  long start = ftell(in);
+  Scanner scanner = newScanner(in);
+  Digraph G = readDigraph(scanner, in, start, writer);
+  freeWriter(&writer);
+  freeScanner(&scanner);
+  fclose(in);
+  if (G == NULL) { // the first line is an error
+    return EXIT_FAILURE;
+  }
+  FILE* out = fopen(outPath, "wb");
+  if (out == NULL) {
+    printf("Unable to write to file %s\n", outPath);
+    freeDigraph(&G);
+    return EXIT_FAILURE;
+  }
+  int status = writeBinaryDigraph(out, G);
+  if (fclose(out) != 0 || status != 0) {
+    printf("Unable to write to file %s\n", outPath);
+    freeDigraph(&G);
+    return EXIT_FAILURE;
+  }
+  freeDigraph(&G);
+  return EXIT_SUCCESS;
+}
+
+/**
+ * closeFiles method that frees the Scanner and closes the files main opened
+ *
+ * @param - pS - the pointer to the Scanner of in
+ * @param - in - the input file, or NULL if there is none
+ * @param - out - the output file, or stdout with --serve
+ */
+static void closeFiles(Scanner* pS, FILE* in, FILE* out) {
+  if (in != NULL) {
+    freeScanner(pS);
+    fclose(in);
+  }
+  if (out != stdout) {
+    fclose(out);
+  }
+}
+
+int main (int argc, char* argv[]) {
+  FILE* out;
+  FILE* in;
+  char* line; // the current input line
+  size_t lineLength; // the length of the current input line
+  int flushEachCommand = 0; // set by --flush to write each answer out as soon as it is ready
+  int threads = 1; // set by --threads to find the SCCs with that many threads
+  long closureMB = 0; // set by --closure to allow a transitive closure of up to that many megabytes
+  bool badOption = false; // an option is missing its value or the value is illegal
+  bool convert = false; // set by --convert to turn a text digraph into a binary file and stop
+  const char* graphPath = NULL; // set by --graph to load the digraph from a binary file
+  bool stats = false; // set by --stats to time every command and count the internal work
+  const char* statsPath = NULL; // set by --stats-file to write the stats there instead of to stderr
+  bool packed = false; // set by --packed to keep the edges compressed until the first change
+  bool serve = false; // set by --serve to keep the digraph loaded and answer lines from standard input
+  const char* socketPath = NULL; // set by --socket to answer lines from the connections to a Unix domain socket
+  const char* journalPath = NULL; // set by --journal to keep the digraph durable in that directory
+  long long checkpointEvery = 1000000; // set by --checkpoint-every to write a checkpoint after that many changes
+
+  int arg = 1; // the first argument that isn't an option
+  while (arg < argc && strncmp(argv[arg], "--", 2) == 0) {
+    if (strcmp(argv[arg], "--flush") == 0) {
+      flushEachCommand = 1;
+    }
+    else if (strcmp(argv[arg], "--threads") == 0) {
+      char* end = NULL;
+      long value = arg + 1 < argc ? strtol(argv[arg + 1], &end, 10) : 0;
+      if (end == NULL || end == argv[arg + 1] || *end != '\0' || value < 1 || value > 1024) {
+        badOption = true;
+        break;
       }
-      
-      else { // there is at least one number provided
-	while (((int) ch < 58) && ((int) ch > 47)) { // until k encounters a space 
-	  digit = digit * 10 + (ch - 48); // convert ch to an int and add it to the existing value of digit
-	  k++; // increment k
-	  ch = *(line + 8 + k); // move onto the next digit
-	}
-	
-	int u = digit; // set the first vertex to digit
-	digit = 0; // reset digit for the next number
-	ch = *(line + 9 + k); // set ch to be the first digit of the next number
-	
-	if (!(((int) ch < 58) && ((int) ch > 47))) { // if there is only one number provided
-	  twoDigits = false; // there aren't two number provided
-	  fprintf(out, "%s", line);
-	  fprintf(out, "ERROR\n"); 
-	}
-	
-	if (twoDigits) { //there are two digits provided
-	  while (((int) ch < 58) && ((int) ch > 47)) { // until k encounters a space
-	    digit = digit * 10 + (ch - 48); // convert ch to an int and add it to the existing value of digit
-	    k++; // increment k
-	            
-	    if (k + 9 == strlen(line) - 1) { // if the program has reached the end of this input line
-	      break;
-	    }
-	    ch = *(line + 9 + k); // move onto the next digit
-	  }
-	      
-	  int v = digit; // set the second vertex to digit
-
-	  if ((u > getOrder(myDigraph)) || (v > getOrder(myDigraph)) || u < 1 || v < 1) { // if u or v is greater than numVertices or if u or v are less than 1
-	    fprintf(out, "%s", line);
-	    fprintf(out, "ERROR\n");
-	  }
-
-	  else if (strlen(line) > 9 + k + 1) { // if there is an additional number
-	    fprintf(out, "%s", line);
-	    fprintf(out, "ERROR\n");
-	  }
-	      
-	  else { // u and v are legal vertices
-	    fprintf(out, "AddEdge %d %d\n", u, v);
-	    fprintf(out, "%d\n", addEdge(myDigraph, u, v));
-	  }
-	}    
+      threads = (int) value;
+      arg++; // skip the value too
+    }
+    else if (strcmp(argv[arg], "--closure") == 0) {
+      char* end = NULL;
+      long value = arg + 1 < argc ? strtol(argv[arg + 1], &end, 10) : 0;
+      if (end == NULL || end == argv[arg + 1] || *end != '\0' || value < 1 || value > 1048576) {
+        badOption = true;
+        break;
       }
+      closureMB = value;
+      arg++; // skip the value too
     }
-
-    if (deleteedge) { // if the input line is DeleteEdge
-      bool twoDigits = true; // used to check if the input line includes 2 vertices
-      int digit = 0; // will be used when the char is converted to an int
-      int k = 0; // used to iterate through the input line
-      char ch = *(line + 11); // set ch to be right after the chars 'DeleteEdge'
-      
-      if (!(((int) ch < 58) && ((int) ch > 47))) { // if there are no numbers provided
-	fprintf(out, "%s", line);
-	fprintf(out, "ERROR\n");
+    else if (strcmp(argv[arg], "--stats") == 0) {
+      stats = true;
+    }
+    else if (strcmp(argv[arg], "--stats-file") == 0) {
+      if (arg + 1 >= argc) {
+        badOption = true;
+        break;
       }
-      
-      else { // there is at least one number provided
-	while (((int) ch < 58) && ((int) ch > 47)) { // until k encounters a space 
-	  digit = digit * 10 + (ch - 48); // convert ch to an int and add it to the existing value of digit
-	  k++; // increment k
-	  ch = *(line + 11 + k); // move onto the next digit
-	}
-	
-	int u = digit; // set the first vertex to digit
-	digit = 0; // reset digit for the next number
-	ch = *(line + 12 + k); // set ch to be the first digit of the next number
-	
-	if (!(((int) ch < 58) && ((int) ch > 47))) { // if there is only one number provided
-	  twoDigits = false; // there aren't two number provided
-	  fprintf(out, "%s", line);
-	  fprintf(out, "ERROR\n"); 
-	}
-	
-	if (twoDigits) { //there are two digits provided
-	  while (((int) ch < 58) && ((int) ch > 47)) { // until k encounters a space
-	    digit = digit * 10 + (ch - 48); // convert ch to an int and add it to the existing value of digit
-	    k++; // increment k
-	            
-	    if (k + 12 == strlen(line) - 1) { // if the program has reached the end of this input line
-	      break;
-	    }
-	    ch = *(line + 12 + k); // move onto the next digit
-	  }
-	      
-	  int v = digit; // set the second vertex to digit
-
-	  if ((u > getOrder(myDigraph)) || (v > getOrder(myDigraph)) || u < 1 || v < 1) { // if u or v is greater than numVertices or if u or v are less than 1
-	    fprintf(out, "%s", line);
-	    fprintf(out, "ERROR\n");
-	  }
-
-	  else if(strlen(line) > 12 + k + 1) { // if there is an additional number
-	    fprintf(out, "%s", line);
-	    fprintf(out, "ERROR\n");
-	  }
-	      
-	  else { // u and v are legal vertices
-	    fprintf(out, "DeleteEdge %d %d\n", u, v);
-	    fprintf(out, "%d\n", deleteEdge(myDigraph, u, v));
-	  }
-	}    
+      stats = true;
+      statsPath = argv[++arg];
+    }
+    else if (strcmp(argv[arg], "--packed") == 0) {
+      packed = true;
+    }
+    else if (strcmp(argv[arg], "--serve") == 0) {
+      serve = true;
+    }
+    else if (strcmp(argv[arg], "--socket") == 0) {
+      if (arg + 1 >= argc) {
+        badOption = true;
+        break;
       }
+      serve = true;
+      socketPath = argv[++arg];
     }
-
-    if (getcountscc) { // if the input line is GetCountSCC                                                                                                                                                 
-      if (strlen(line) > 12) { // if there are any characters after GetCountSCC                                                                                                                           
-        fprintf(out, "%s", line);
-	fprintf(out, "ERROR\n");
+    else if (strcmp(argv[arg], "--journal") == 0) {
+      if (arg + 1 >= argc) {
+        badOption = true;
+        break;
       }
-
-      else {
-        fprintf(out, "GetCountSCC\n");
-        fprintf(out, "%d\n", getCountSCC(myDigraph));
+      journalPath = argv[++arg];
+    }
+    else if (strcmp(argv[arg], "--checkpoint-every") == 0) {
+      char* end = NULL;
+      long long value = arg + 1 < argc ? strtoll(argv[arg + 1], &end, 10) : 0;
+      if (end == NULL || end == argv[arg + 1] || *end != '\0' || value < 1) {
+        badOption = true;
+        break;
+      }
+      checkpointEvery = value;
+      arg++; // skip the value too
+    }
+    else if (strcmp(argv[arg], "--convert") == 0) {
+      convert = true;
+    }
+    else if (strcmp(argv[arg], "--graph") == 0) {
+      if (arg + 1 >= argc) {
+        badOption = true;
+        break;
       }
+      graphPath = argv[++arg];
+    }
+    else {
+      break; // an unknown option is reported as a usage error below
     }
+    arg++;
+  }
 
-    if (getnumsccvertices) { // if the input line is GetNumSCCVertices                                                                                                                                              
-      int digit = 0; // will be used when the char is converted to an int                                                                                                                                  
-      int k = 0; // used to iterate through the input line                                                                                                                                                 
-      char ch = *(line + 18); // set ch to be right after the chars 'getNumSCCVertices'                                                                                                                         
+  // check command line for correct number of arguments (--serve only reads the digraph, from the binary
+  // file or from the first line of the input file, and not even that if --journal has a checkpoint)
+  int files = serve ? (graphPath != NULL ? 0 : 1) : 2;
+  if (serve && journalPath != NULL && graphPath == NULL && argc - arg == 0) {
+    files = 0;
+  }
+  if( badOption || argc - arg != files || (convert && (graphPath != NULL || serve)) || (journalPath != NULL && !serve) ){
+    printf("Usage: %s [--flush] [--threads N] [--closure MB] [--stats | --stats-file <file>] [--packed] "
+        "[--graph <binary file>] "
+        "<input file> <output file>\n", argv[0]);
+    printf("       %s --serve [--socket <path>] [--journal <directory> [--checkpoint-every N]] [--flush] "
+        "[--threads N] [--closure MB] [--stats | --stats-file <file>] [--packed] "
+        "(--graph <binary file> | <input file>)\n", argv[0]);
+    printf("       %s --convert <input file> <binary file>\n", argv[0]);
+    exit(EXIT_FAILURE);
+  }
+  if (convert) {
+    return convertDigraph(argv[arg], argv[arg + 1]);
+  }
+  
+  // open input file for reading
+  in = files >= 1 ? fopen(argv[arg], "r") : NULL;
+  if( files >= 1 && in==NULL ){
+    printf("Unable to read from file %s\n", argv[arg]);
+    exit(EXIT_FAILURE);
+  }
+  
+  // open output file for writing (with --serve, only an error in the first line is written to standard output)
+  out = files == 2 ? fopen (argv[arg + 1], "w") : stdout;
+  if( out==NULL ){
+    printf("Unable to write to file %s\n", argv[arg + 1]);
+    exit(EXIT_FAILURE);
+  }
 
-      if (!(((int) ch < 58) && ((int) ch > 47))) { // if there is no number provided                                                                                                                       
-        fprintf(out, "%s", line);
-        fprintf(out, "ERROR\n");
-      }
+  StatsCounters counters = {0};
+  long long startNanos = 0;
+  if (stats) {
+    statsCounters = &counters; // the Digraph ADT counts its work from here on
+    startNanos = statsNanos();
+  }
 
-      else{ // there is a number provided                                                                                                                                                                  
-        while (((int) ch < 58) && ((int) ch > 47)) { // until k encounters a space                                                                                                                         
-          if (k + 18 == strlen(line) - 1) { // once the end of the input line as been reached                                                                                                              
-            break;
-          }
-          digit = digit * 10 + (ch - 48); // convert ch to an int and add it to the existing value of digit                                                                                                
-          k++; // increment k                                                                                                                                                                              
-          ch = *(line + 18 + k); // move onto the next digit                                                                                                                                               
-        }
-
-        int u = digit; // set u to be the converted int                                                                                                                                                    
-        if (u > getOrder(myDigraph) || u < 1) { // if u is greater than numVertices or less than 1                                                                                                         
-          fprintf(out, "%s", line);
-          fprintf(out, "ERROR\n");
-        }
-
-        else if (strlen(line) - 1 > 18 + k) { // if there is an additional number                                                                                                                          
-          fprintf(out, "%s", line);
-          fprintf(out, "ERROR\n");
-        }
-
-        else {
-          fprintf(out, "GetNumSCCVertices %d\n", u);
-	  fprintf(out, "%d\n", getNumSCCVertices(myDigraph, u));
-        }
-      }
+  Writer writer = newWriter(out, flushEachCommand); // buffers everything written to out
+  Session* session = malloc(sizeof(Session));
+  session->latencies = stats ? calloc(NUMCOMMANDS, sizeof(LatencyHistogram)) : NULL;
+  session->errorLines = 0;
+  session->server = NULL;
+  long start = in != NULL ? ftell(in) : -1; // where the first line starts, in case it has to be echoed
+  Scanner scanner = in != NULL ? newScanner(in) : NULL; // reads the input a chunk at a time
+  Journal journal = journalPath != NULL ? newJournal(journalPath, checkpointEvery, flushEachCommand) : NULL;
+  bool recovered = journal != NULL && hasCheckpoint(journal); // a restart loads the checkpoint instead
+  Digraph myDigraph;
+  if (recovered) { // the last checkpoint with the journal after it replayed
+    myDigraph = recoverJournal(journal);
+    if (myDigraph == NULL) {
+      printf("Unable to recover from journal %s\n", journalPath);
     }
+  }
+  else if (graphPath != NULL) { // every line of the input is a command
+    myDigraph = mapBinaryDigraph(graphPath);
+    if (myDigraph == NULL) {
+      printf("Unable to read binary digraph %s\n", graphPath);
+    }
+  }
+  else if (in == NULL) { // only --journal was given to load from
+    myDigraph = NULL;
+    printf("No checkpoint to recover from in journal %s\n", journalPath);
+  }
+  else {
+    myDigraph = readDigraph(scanner, in, start, writer); // create the Digraph from the first line
+  }
+  if (myDigraph != NULL && journal != NULL && !recovered && checkpointJournal(journal, myDigraph) != 0) {
+    printf("Unable to write to journal %s\n", journalPath); // the first checkpoint is what a restart starts from
+    freeDigraph(&myDigraph);
+  }
+  if (myDigraph == NULL) { // the digraph couldn't be loaded, or the first line is an error
+    free(session->latencies);
+    free(session);
+    freeWriter(&writer);
+    closeFiles(&scanner, in, out);
+    if (journal != NULL) {
+      freeJournal(&journal);
+    }
+    return serve || graphPath != NULL ? EXIT_FAILURE : EXIT_SUCCESS; // only an error in the first line of a file is answered
+  }
 
-    if (insamescc) { // if the input line is InSameSCC
-      bool twoDigits = true; // used to check if the input line includes 2 vertices
-      int digit = 0; // will be used when the char is converted to an int
-      int k = 0; // used to iterate through the input line
-      char ch = *(line + 10); // set ch to be right after the chars 'InSameSCC'
-
-      if (!(((int) ch < 58) && ((int) ch > 47))) { // if there are no numbers provided
-        fprintf(out, "%s", line);
-        fprintf(out, "ERROR\n");
-      }
+  /////////////////////////////////////////////////////////////////////
+  // Graph has been created
+  /////////////////////////////////////////////////////////////////////
+  
+  long long loadNanos = stats ? statsNanos() - startNanos : 0;
+  initCommandTable();
+  setSCCThreads(myDigraph, threads);
+  setClosureLimit(myDigraph, (size_t) closureMB << 20);
+  if (packed) {
+    packDigraph(myDigraph);
+  }
+  session->G = myDigraph;
+  session->journal = journal;
+  session->out = writer;
+  session->batching = !flushEachCommand; // holding answers back would defeat --flush
+  session->pendingCount = 0;
+  int status = EXIT_SUCCESS;
+  if (serve) { // the rest of the input file isn't read; the lines come from the clients
+    ServerHandler handler = {session, openSession, serveLine, commitChanges, finishLines, closeSession};
+    if (runServer(socketPath, &handler) != 0) {
+      printf("Unable to listen on socket %s\n", socketPath);
+      status = EXIT_FAILURE;
+    }
+  }
+  else {
+    while ((line = scanLine(scanner, &lineLength)) != NULL) { // while there is a next line in the input file
+      processLine(session, line, lineLength);
+    }
+    flushPending(session); // answer a run of InSameSCC lines at the end of the file
+  }
 
-      else { // there is at least one number provided
-        while (((int) ch < 58) && ((int) ch > 47)) { // until k encounters a space
-          digit = digit * 10 + (ch - 48); // convert ch to an int and add it to the existing value of digit
-          k++; // increment k
-          ch = *(line + 10 + k); // move onto the next digit
-        }
-
-        int u = digit; // set the first vertex to digit
-        digit = 0; // reset digit for the next number
-        ch = *(line + 11 + k); // set ch to be the first digit of the next number
-
-        if (!(((int) ch < 58) && ((int) ch > 47))) { // if there is only one number provided
-          twoDigits = false; // there aren't two number provided
-          fprintf(out, "%s", line);
-          fprintf(out, "ERROR\n");
-        }
-
-        if (twoDigits) { //there are two digits provided
-          while (((int) ch < 58) && ((int) ch > 47)) { // until k encounters a space
-            digit = digit * 10 + (ch - 48); // convert ch to an int and add it to the existing value of digit
-            k++; // increment k
-
-            if (k + 11 == strlen(line) - 1) { // if the program has reached the end of this input line
-              break;
-            }
-            ch = *(line + 11 + k); // move onto the next digit
-          }
-
-          int v = digit; // set the second vertex to digit
-          if ((u > getOrder(myDigraph)) || (v > getOrder(myDigraph)) || u < 1 || v < 1) { // if u or v is greater than numVertices or if u or v are less than 1
-            fprintf(out, "%s", line);
-            fprintf(out, "ERROR\n");
-          }
-
-          else if(strlen(line) > 11 + k + 1) { // if there is an additional number
-            fprintf(out, "%s", line);
-            fprintf(out, "ERROR\n");
-          }
-
-          else { // u and v are legal vertices
-            fprintf(out, "InSameSCC %d %d\n", u, v);
-	    if (inSameSCC(myDigraph, u, v) == 0) {
-	      fprintf(out, "NO\n");
-	    }
-	    else if (inSameSCC(myDigraph, u, v) == 1) {
-	      fprintf(out, "YES\n");
-	    }
-	    else if (inSameSCC(myDigraph, u, v) == -1) {
-	      fprintf(out, "ERROR\n");
-	    }
-          }
-        }
+  if (stats) {
+    long long totalNanos = statsNanos() - startNanos;
+    FILE* statsOut = statsPath != NULL ? fopen(statsPath, "w") : stderr;
+    if (statsOut == NULL) {
+      printf("Unable to write to file %s\n", statsPath);
+    }
+    else {
+      writeStats(statsOut, session, &counters, loadNanos, totalNanos);
+      if (statsOut != stderr) {
+        fclose(statsOut);
       }
     }
-
-    // set all the const chars to NULL
-    printdigraph = NULL;
-    getorder = NULL;
-    getsize = NULL;
-    getoutdegree = NULL;
-    addedge = NULL;
-    deleteedge = NULL;
-    getcountscc = NULL;
-    getnumsccvertices = NULL;
-    insamescc = NULL;
+    statsCounters = NULL;
   }
-  
+
+  free(session->latencies);
+  free(session);
+  freeWriter(&writer); // writes out whatever is still buffered
   freeDigraph(&myDigraph); // safely deallocate the heap memory used for the Digraph
-  fclose(in);
-  fclose(out);
-  return (EXIT_SUCCESS);
+  closeFiles(&scanner, in, out);
+  if (journal != NULL) { // every change was committed before it was answered
+    freeJournal(&journal);
+  }
+  return status;
 }
@@ -0,0 +1,171 @@
+/************************************************************
+ * DigraphTest.c
+ * Tyler Hoang
+ * Regression tests for the Digraph ADT. Prints each test that fails and exits with a failure
+ * status if any did (make test)
+ ************************************************************/
+#include "Digraph.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdint.h>
+
+#define CHECKPOINT_PATH "DigraphTest.bin" // the checkpoint each test writes, removed at the end
+
+static int failures = 0; // the number of checks that failed
+
+/**
+ * check method that reports a check that failed
+ *
+ * @param - ok - whether the check passed
+ * @param - what - what was checked
+ */
+static void check(int ok, const char* what) {
+  if (!ok) {
+    printf("FAILED: %s\n", what);
+    failures++;
+  }
+}
+
+/**
+ * twoCycles method that returns the digraph 4, 1 2, 2 1, 3 4, 4 3: two SCCs, {1, 2} and {3, 4}, with no
+ * edge between them
+ */
+static Digraph twoCycles(void) {
+  int us[] = {1, 2, 3, 4};
+  int vs[] = {2, 1, 4, 3};
+  return newDigraphFromEdges(4, us, vs, 4);
+}
+
+/**
+ * writeCheckpointFile method that writes a checkpoint of G to CHECKPOINT_PATH and returns its bytes
+ *
+ * @param - G - the Digraph
+ * @param - size - set to the number of bytes
+ * @return - the bytes of the checkpoint, or NULL if it couldn't be written
+ */
+static unsigned char* writeCheckpointFile(Digraph G, long* size) {
+  FILE* out = fopen(CHECKPOINT_PATH, "wb");
+  if (out == NULL || writeCheckpoint(out, G) != 0) {
+    if (out != NULL) {
+      fclose(out);
+    }
+    return NULL;
+  }
+  fclose(out);
+  FILE* in = fopen(CHECKPOINT_PATH, "rb");
+  fseek(in, 0, SEEK_END);
+  *size = ftell(in);
+  rewind(in);
+  unsigned char* bytes = malloc(*size);
+  *size = (long) fread(bytes, 1, *size, in);
+  fclose(in);
+  return bytes;
+}
+
+/**
+ * labellingHash method that returns the FNV-1a hash of count int32s, the way writeCheckpoint hashes the
+ * SCC labelling
+ */
+static uint32_t labellingHash(const unsigned char* bytes, size_t count) {
+  uint32_t hash = 2166136261u;
+  for (size_t i = 0; i < count; i++) {
+    int32_t word;
+    memcpy(&word, bytes + 4 * i, 4);
+    for (int b = 0; b < 4; b++) {
+      hash = (hash ^ (((uint32_t) word >> (8 * b)) & 0xFF)) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+/**
+ * rewriteFile method that replaces CHECKPOINT_PATH with size bytes
+ */
+static void rewriteFile(const unsigned char* bytes, long size) {
+  FILE* out = fopen(CHECKPOINT_PATH, "wb");
+  fwrite(bytes, 1, size, out);
+  fclose(out);
+}
+
+/**
+ * checkTwoCycles method that checks the answers of a digraph loaded from a checkpoint of twoCycles
+ *
+ * @param - G - the loaded Digraph (NULL if it couldn't be loaded)
+ * @param - name - the name of the test
+ */
+static void checkTwoCycles(Digraph G, const char* name) {
+  char what[128];
+  snprintf(what, sizeof(what), "%s: the checkpoint loads", name);
+  check(G != NULL, what);
+  if (G == NULL) {
+    return;
+  }
+  snprintf(what, sizeof(what), "%s: GetCountSCC is 2", name);
+  check(getCountSCC(G) == 2, what);
+  snprintf(what, sizeof(what), "%s: 1 and 2 are in the same SCC", name);
+  check(inSameSCC(G, 1, 2) == 1, what);
+  snprintf(what, sizeof(what), "%s: 1 and 3 aren't in the same SCC", name);
+  check(inSameSCC(G, 1, 3) == 0, what);
+  snprintf(what, sizeof(what), "%s: 1 can't reach 3", name);
+  check(canReach(G, 1, 3) == 0, what);
+  snprintf(what, sizeof(what), "%s: 1 reaches 2 vertices", name);
+  check(getReachableCount(G, 1) == 2, what);
+}
+
+/**
+ * testCheckpointLabelling method that checks that a checkpoint loads with the right SCCs, and that one
+ * whose SCC labelling was damaged still gives the right answers instead of trusting the labelling
+ */
+static void testCheckpointLabelling(void) {
+  Digraph G = twoCycles();
+  long size = 0;
+  unsigned char* bytes = writeCheckpointFile(G, &size);
+  freeDigraph(&G);
+  check(bytes != NULL, "a checkpoint is written");
+  if (bytes == NULL) {
+    return;
+  }
+
+  G = mapBinaryDigraph(CHECKPOINT_PATH);
+  checkTwoCycles(G, "intact checkpoint");
+  freeDigraph(&G);
+
+  // the labelling is 12 int32s (numSCCs and numFree, both 2, the two SCCs' slots, their sizes, the four
+  // vertices and the two free slots) and then its hash; swapping the second and third vertices puts 1
+  // and 3 in one SCC
+  unsigned char* labelling = bytes + size - 52;
+  int32_t counts[2];
+  memcpy(counts, labelling, sizeof(counts));
+  check(counts[0] == 2 && counts[1] == 2, "the checkpoint has 2 SCCs and 2 free slots");
+  unsigned char* swapped = malloc(size);
+  memcpy(swapped, bytes, size);
+  memcpy(swapped + (labelling - bytes) + 28, labelling + 32, 4);
+  memcpy(swapped + (labelling - bytes) + 32, labelling + 28, 4);
+  rewriteFile(swapped, size);
+  G = mapBinaryDigraph(CHECKPOINT_PATH);
+  checkTwoCycles(G, "swapped vertices");
+  freeDigraph(&G);
+
+  // the same swap with its hash written too is still caught, since the edge 2 -> 1 goes back in the order
+  uint32_t hash = labellingHash(swapped + (labelling - bytes), 12);
+  memcpy(swapped + size - 4, &hash, 4);
+  rewriteFile(swapped, size);
+  G = mapBinaryDigraph(CHECKPOINT_PATH);
+  checkTwoCycles(G, "swapped vertices with a matching hash");
+  freeDigraph(&G);
+
+  free(swapped);
+  free(bytes);
+  remove(CHECKPOINT_PATH);
+}
+
+int main(void) {
+  testCheckpointLabelling();
+  if (failures > 0) {
+    printf("%d checks failed\n", failures);
+    return EXIT_FAILURE;
+  }
+  printf("All checks passed\n");
+  return EXIT_SUCCESS;
+}
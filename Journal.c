@@ -0,0 +1,366 @@
+/************************************************************
+ * Journal.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Journal.h
+ ************************************************************/
+#define _POSIX_C_SOURCE 200809L // for fsync, fdatasync, ftruncate and strdup
+#include <errno.h>
+#include <fcntl.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+#include "Journal.h"
+
+#define JOURNAL_MAGIC "DGJOURN" // the first 8 bytes of a journal file (with the NUL)
+#define JOURNAL_FORMAT_VERSION 1
+#define JOURNAL_BYTE_ORDER 0x01020304u // reads back differently on a machine with the other byte order
+
+/**
+ * JournalHeader typedef struct that starts a journal file. It is followed by JournalRecords, in the byte
+ * order of the machine that wrote the file
+ */
+typedef struct JournalHeader {
+  char magic[8]; // JOURNAL_MAGIC
+  uint32_t formatVersion; // JOURNAL_FORMAT_VERSION
+  uint32_t byteOrder; // JOURNAL_BYTE_ORDER
+} JournalHeader;
+
+/**
+ * JournalRecord typedef struct that holds one AddEdge or DeleteEdge that changed the digraph
+ */
+typedef struct JournalRecord {
+  int32_t added; // 1 for AddEdge, 0 for DeleteEdge
+  int32_t u;
+  int32_t v;
+  uint32_t check; // recordCheck of the other three
+} JournalRecord;
+
+/**
+ * JournalObj struct that holds the files of a Journal and the records that haven't been written
+ */
+struct JournalObj {
+  char* directory;
+  char* checkpointPath; // directory/checkpoint
+  char* journalPath; // directory/journal
+  int fd; // the journal file, open for appending (-1 until a checkpoint is recovered or written)
+  JournalRecord pending[JOURNAL_BUFFER]; // the records that haven't been written to the file
+  int numPending;
+  bool written; // whether records were written to the file since the last sync
+  bool failed; // whether a write failed since the last commit
+  long long sinceCheckpoint; // the number of records in the journal file and pending
+  long long checkpointInterval;
+  bool syncEach;
+};
+
+/**
+ * recordCheck method that returns the FNV-1a hash of the fields of a record. A record that was cut off or
+ * never finished (such as one a crash left zeroed) fails the check
+ */
+static uint32_t recordCheck(const JournalRecord* R) {
+  uint32_t words[3] = {(uint32_t) R->added, (uint32_t) R->u, (uint32_t) R->v};
+  uint32_t hash = 2166136261u;
+  for (int i = 0; i < 3; i++) {
+    for (int b = 0; b < 4; b++) {
+      hash = (hash ^ ((words[i] >> (8 * b)) & 0xFF)) * 16777619u;
+    }
+  }
+  return hash;
+}
+
+/**
+ * joinPath method that returns directory/name in a new string
+ */
+static char* joinPath(const char* directory, const char* name) {
+  size_t length = strlen(directory) + 1 + strlen(name) + 1;
+  char* path = malloc(length);
+  snprintf(path, length, "%s/%s", directory, name);
+  return path;
+}
+
+/**
+ * writeAll method that writes the n bytes at data to fd, however many write calls that takes
+ *
+ * @return - whether every byte was written
+ */
+static bool writeAll(int fd, const void* data, size_t n) {
+  const char* at = data;
+  while (n > 0) {
+    ssize_t written = write(fd, at, n);
+    if (written < 0 && errno == EINTR) {
+      continue;
+    }
+    if (written <= 0) {
+      return false;
+    }
+    at += written;
+    n -= (size_t) written;
+  }
+  return true;
+}
+
+/**
+ * syncDirectory method that syncs the directory of J so that a rename in it survives a crash
+ *
+ * @return - whether the sync succeeded
+ */
+static bool syncDirectory(Journal J) {
+  int fd = open(J->directory, O_RDONLY);
+  if (fd < 0) {
+    return false;
+  }
+  bool ok = fsync(fd) == 0;
+  close(fd);
+  return ok;
+}
+
+/**
+ * writePending method that writes the pending records to the journal file without syncing it
+ */
+static void writePending(Journal J) {
+  if (J->numPending == 0) {
+    return;
+  }
+  if (!writeAll(J->fd, J->pending, sizeof(JournalRecord) * J->numPending)) {
+    J->failed = true;
+  }
+  J->numPending = 0;
+  J->written = true;
+}
+
+/**
+ * syncPending method that writes the pending records and syncs the journal file if anything was written
+ */
+static void syncPending(Journal J) {
+  writePending(J);
+  if (J->written && fdatasync(J->fd) != 0) {
+    J->failed = true;
+  }
+  J->written = false;
+}
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newJournal method that returns a Journal kept in directory
+ *
+ * @param - directory - the directory of the checkpoint and journal files (made if it doesn't exist)
+ * @param - checkpointInterval - the number of records committed between two checkpoints
+ * @param - syncEach - whether each record is written and synced as soon as it is added
+ * @return - the new Journal
+ */
+Journal newJournal(const char* directory, long long checkpointInterval, bool syncEach) {
+  mkdir(directory, 0777); // fails harmlessly if it is already there
+  Journal J = malloc(sizeof(struct JournalObj));
+  J->directory = strdup(directory);
+  J->checkpointPath = joinPath(directory, "checkpoint");
+  J->journalPath = joinPath(directory, "journal");
+  J->fd = -1;
+  J->numPending = 0;
+  J->written = false;
+  J->failed = false;
+  J->sinceCheckpoint = 0;
+  J->checkpointInterval = checkpointInterval;
+  J->syncEach = syncEach;
+  return J;
+}
+
+/**
+ * freeJournal method that frees the heap memory used by the Journal and closes its file
+ *
+ * @param - pJ - the pointer to the Journal
+ */
+void freeJournal(Journal* pJ) {
+  Journal J = *pJ;
+  if (J->fd >= 0) {
+    close(J->fd);
+  }
+  free(J->directory);
+  free(J->checkpointPath);
+  free(J->journalPath);
+  free(J);
+  *pJ = NULL;
+}
+
+/*** Access functions ***/
+
+/**
+ * hasCheckpoint method that returns whether the directory holds a checkpoint
+ */
+bool hasCheckpoint(Journal J) {
+  return access(J->checkpointPath, F_OK) == 0;
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * startJournal method that replaces the journal file with an empty one and keeps it open for appending
+ *
+ * @return - whether the new file was written and synced
+ */
+static bool startJournal(Journal J) {
+  char* temporary = joinPath(J->directory, "journal.tmp");
+  int fd = open(temporary, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0666);
+  JournalHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, JOURNAL_MAGIC, sizeof(header.magic));
+  header.formatVersion = JOURNAL_FORMAT_VERSION;
+  header.byteOrder = JOURNAL_BYTE_ORDER;
+  bool ok = fd >= 0 && writeAll(fd, &header, sizeof(header)) && fsync(fd) == 0
+      && rename(temporary, J->journalPath) == 0 && syncDirectory(J);
+  free(temporary);
+  if (!ok) {
+    if (fd >= 0) {
+      close(fd);
+    }
+    return false;
+  }
+  if (J->fd >= 0) {
+    close(J->fd);
+  }
+  J->fd = fd;
+  J->sinceCheckpoint = 0;
+  return true;
+}
+
+/**
+ * recoverJournal method that loads the checkpoint and replays the journal after it. Records are read up
+ * to the first one that is cut off, fails its check or names a vertex the digraph doesn't have; the file
+ * is truncated there so that new records follow the last good one
+ *
+ * @param - J - the Journal
+ * @return - the recovered Digraph, or NULL if the checkpoint or the journal can't be read
+ */
+Digraph recoverJournal(Journal J) {
+  Digraph G = mapBinaryDigraph(J->checkpointPath);
+  if (G == NULL) {
+    return NULL;
+  }
+  int fd = open(J->journalPath, O_RDWR | O_APPEND);
+  if (fd < 0) { // a crash before the first journal was made; the checkpoint has everything
+    if (!startJournal(J)) {
+      freeDigraph(&G);
+      return NULL;
+    }
+    return G;
+  }
+
+  JournalHeader header;
+  bool ok = read(fd, &header, sizeof(header)) == (ssize_t) sizeof(header)
+      && memcmp(header.magic, JOURNAL_MAGIC, sizeof(header.magic)) == 0
+      && header.formatVersion == JOURNAL_FORMAT_VERSION && header.byteOrder == JOURNAL_BYTE_ORDER;
+  if (!ok) {
+    close(fd);
+    freeDigraph(&G);
+    return NULL;
+  }
+
+  struct stat info;
+  if (fstat(fd, &info) == 0 && (size_t) info.st_size > sizeof(header)) { // one search after the replay
+    forgetSCCs(G); // costs less than keeping the restored SCCs up to date through every record
+  }
+  int order = getOrder(G);
+  long long replayed = 0;
+  bool intact = true; // whether every record read so far is good
+  while (intact) { // read a buffer of records at a time, into the pending buffer that is still empty
+    ssize_t n = read(fd, J->pending, sizeof(J->pending));
+    if (n <= 0) {
+      break;
+    }
+    int count = (int) (n / (ssize_t) sizeof(JournalRecord));
+    intact = n % (ssize_t) sizeof(JournalRecord) == 0;
+    for (int i = 0; i < count; i++) {
+      JournalRecord* R = &J->pending[i];
+      if (R->check != recordCheck(R) || (R->added != 0 && R->added != 1)
+          || R->u < 1 || R->u > order || R->v < 1 || R->v > order) {
+        intact = false;
+        break;
+      }
+      if (R->added) {
+        addEdge(G, R->u, R->v);
+      }
+      else {
+        deleteEdge(G, R->u, R->v);
+      }
+      replayed++;
+    }
+  }
+  off_t valid = (off_t) (sizeof(JournalHeader) + sizeof(JournalRecord) * (size_t) replayed);
+  if (!intact && (ftruncate(fd, valid) != 0 || fsync(fd) != 0)) { // drop the record cut off by the crash
+    close(fd);
+    freeDigraph(&G);
+    return NULL;
+  }
+  J->fd = fd;
+  J->sinceCheckpoint = replayed;
+  return G;
+}
+
+/**
+ * checkpointJournal method that writes a checkpoint of G and starts an empty journal. The checkpoint is
+ * written to a temporary file, synced and renamed over the old one, and only then is the journal replaced
+ *
+ * @param - J - the Journal
+ * @param - G - the Digraph
+ * @return - 0 on success, -1 if writing failed
+ */
+int checkpointJournal(Journal J, Digraph G) {
+  if (J->fd >= 0) { // the records so far go to the old journal first, in case the checkpoint fails
+    syncPending(J);
+  }
+  char* temporary = joinPath(J->directory, "checkpoint.tmp");
+  FILE* out = fopen(temporary, "wb");
+  bool ok = out != NULL && writeCheckpoint(out, G) == 0 && fsync(fileno(out)) == 0;
+  ok = (out != NULL && fclose(out) == 0) && ok;
+  ok = ok && rename(temporary, J->checkpointPath) == 0 && syncDirectory(J);
+  free(temporary);
+  ok = ok && startJournal(J);
+  if (ok) { // the checkpoint holds every record, even ones an earlier failed write lost
+    J->failed = false;
+  }
+  return ok ? 0 : -1;
+}
+
+/**
+ * journalEdge method that adds the record of an AddEdge or a DeleteEdge that changed the digraph
+ *
+ * @param - J - the Journal
+ * @param - added - true for AddEdge, false for DeleteEdge
+ * @param - u - the first vertex
+ * @param - v - the second vertex
+ */
+void journalEdge(Journal J, bool added, int u, int v) {
+  if (J->numPending == JOURNAL_BUFFER) {
+    writePending(J);
+  }
+  JournalRecord* R = &J->pending[J->numPending++];
+  R->added = added ? 1 : 0;
+  R->u = u;
+  R->v = v;
+  R->check = recordCheck(R);
+  J->sinceCheckpoint++;
+  if (J->syncEach) {
+    syncPending(J);
+  }
+}
+
+/**
+ * commitJournal method that writes and syncs the records added since the last commit, and writes a new
+ * checkpoint once enough records have been committed since the last one
+ *
+ * @param - J - the Journal
+ * @param - G - the Digraph the records were applied to
+ * @return - 0 on success, -1 if writing failed
+ */
+int commitJournal(Journal J, Digraph G) {
+  syncPending(J);
+  if (J->failed) {
+    return -1;
+  }
+  if (J->sinceCheckpoint >= J->checkpointInterval) {
+    return checkpointJournal(J, G);
+  }
+  return 0;
+}
@@ -0,0 +1,59 @@
+/************************************************************
+ * Journal.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef JOURNAL_H
+#define JOURNAL_H
+
+#include <stdbool.h>
+#include "Digraph.h"
+
+#define JOURNAL_BUFFER 4096 // the most records held in memory before they are written to the file
+
+// A directory that keeps a digraph that changes durable across restarts. It holds two files:
+// - checkpoint: the whole digraph and its SCCs, written by writeCheckpoint
+// - journal: every AddEdge and DeleteEdge that changed the digraph since that checkpoint, as fixed
+//   size records that each carry a checksum, so a record cut off by a crash is recognized
+// Records are collected in memory and written and synced together by commitJournal (group commit),
+// so a batch of changes costs one sync. Once checkpointInterval records have been committed, the
+// next commitJournal writes a new checkpoint and starts an empty journal, which bounds how many
+// records recovery has to replay. Each file is replaced by writing a new one and renaming it over
+// the old one, so a crash leaves either file whole. Replaying records that the checkpoint already
+// holds leaves the digraph the same (an edge ends up the way the last record for it left it), so a
+// crash between the two renames is harmless.
+
+// private JournalObj type
+typedef struct JournalObj* Journal;
+
+// Constructors-Destructors ---------------------------------------------------
+Journal newJournal(const char* directory, long long checkpointInterval, bool syncEach); // returns
+// a Journal kept in directory (which is made if it doesn't exist). If syncEach is true, every
+// record is written and synced as soon as it is added.
+
+void freeJournal(Journal* pJ); // frees all heap memory associated with its Journal* argument,
+// closes its file and sets *pJ to NULL. Records that weren't committed are lost.
+
+
+// Access functions -----------------------------------------------------------
+bool hasCheckpoint(Journal J); // Returns whether the directory holds a checkpoint to recover from.
+
+
+// Manipulation procedures ----------------------------------------------------
+Digraph recoverJournal(Journal J); // Returns the digraph in the checkpoint with every record of the
+// journal after it replayed, or NULL if the checkpoint or the journal can't be read. A record cut
+// off by a crash (and anything after it) is dropped from the journal. New records are appended
+// after the ones replayed.
+
+int checkpointJournal(Journal J, Digraph G); // Writes a checkpoint of G and starts an empty journal.
+// Returns 0 on success and -1 if writing failed.
+
+void journalEdge(Journal J, bool added, int u, int v); // Adds the record of an AddEdge (added) or a
+// DeleteEdge of u and v that changed the digraph. Precondition: a checkpoint has been recovered or
+// written.
+
+int commitJournal(Journal J, Digraph G); // Writes the records that were added since the last commit
+// and syncs them to disk, then writes a new checkpoint of G if checkpointInterval records have been
+// committed since the last one. Returns 0 on success and -1 if writing failed, in which case the
+// records since the last successful commit may not have reached the disk.
+
+#endif
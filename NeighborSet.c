@@ -0,0 +1,408 @@
+/************************************************************
+ * NeighborSet.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in NeighborSet.h
+ ************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "NeighborSet.h"
+
+#define EMPTY_SLOT 0 // a hash slot that has never been used
+#define DELETED_SLOT -1 // a hash slot whose neighbor was removed (slots store neighbor + 1)
+
+/**
+ * itemsOf method that returns the array the neighbors are currently stored in
+ *
+ * @param - S - the NeighborSet
+ * @return - the inline array or the heap array
+ */
+static int* itemsOf(NeighborSet S) {
+  return S->capacity == 0 ? S->store.inlineItems : S->store.items;
+}
+
+/**
+ * ownItems method that copies a borrowed array into memory the set owns, so it can be changed
+ *
+ * @param - S - the NeighborSet
+ */
+static void ownItems(NeighborSet S) {
+  if (S->capacity >= 0) {
+    return; // already owned
+  }
+  const int* borrowed = S->store.items;
+  S->capacity = 0;
+  setSortedNeighbors(S, borrowed, S->count); // copies the neighbors and adds a hash index if the set is large
+}
+
+/**
+ * lowerBound method that returns the index of the first value in the ascending array a that is not less than x
+ *
+ * @param - a - the array
+ * @param - n - the number of values in a
+ * @param - x - the value to search for
+ * @return - the index (n if every value is less than x)
+ */
+static int lowerBound(const int* a, int n, int x) {
+  int lo = 0;
+  int hi = n;
+  while (lo < hi) {
+    int mid = lo + (hi - lo) / 2;
+    if (a[mid] < x) {
+      lo = mid + 1;
+    }
+    else {
+      hi = mid;
+    }
+  }
+  return lo;
+}
+
+/**
+ * compareInts method used by qsort to sort ints in ascending order
+ */
+static int compareInts(const void* a, const void* b) {
+  int x = *(const int*) a;
+  int y = *(const int*) b;
+  return (x > y) - (x < y);
+}
+
+/**
+ * findSlot method that returns the hash slot holding x, or -1 if x isn't in the hash index
+ *
+ * @param - S - the NeighborSet
+ * @param - x - the neighbor
+ * @return - the slot index or -1
+ */
+static int findSlot(NeighborSet S, int x) {
+  int mask = S->slotCount - 1;
+  int i = (int) (((unsigned) x * 2654435761u) & (unsigned) mask); // multiplicative hashing
+  while (S->slots[i] != EMPTY_SLOT) { // linear probing until an empty slot ends the chain
+    if (S->slots[i] == x + 1) {
+      return i;
+    }
+    i = (i + 1) & mask;
+  }
+  return -1;
+}
+
+/**
+ * placeInSlots method that stores x in the first free slot of its probe sequence
+ * Precondition: x isn't in the hash index and there is a free slot
+ *
+ * @param - S - the NeighborSet
+ * @param - x - the neighbor
+ */
+static void placeInSlots(NeighborSet S, int x) {
+  int mask = S->slotCount - 1;
+  int i = (int) (((unsigned) x * 2654435761u) & (unsigned) mask);
+  while (S->slots[i] != EMPTY_SLOT) {
+    i = (i + 1) & mask;
+  }
+  S->slots[i] = x + 1;
+  S->slotsUsed++;
+}
+
+/**
+ * rebuildSlots method that rebuilds the hash index from the sorted array, sized for count neighbors
+ * Precondition: items holds exactly the count neighbors (no deleted or duplicate entries)
+ *
+ * @param - S - the NeighborSet
+ */
+static void rebuildSlots(NeighborSet S) {
+  int slotCount = 16;
+  while (slotCount < S->count * 2) { // keep the load factor at or below 1/2
+    slotCount *= 2;
+  }
+  free(S->slots);
+  S->slots = calloc(slotCount, sizeof(int));
+  S->slotCount = slotCount;
+  S->slotsUsed = 0;
+  int* a = itemsOf(S);
+  for (int i = 0; i < S->length; i++) {
+    placeInSlots(S, a[i]);
+  }
+}
+
+/**
+ * normalize method that sorts the heap array of a hashed set again, dropping the deleted and duplicate
+ * entries that inserts and removes leave behind
+ *
+ * @param - S - the NeighborSet
+ */
+static void normalize(NeighborSet S) {
+  if (S->slots == NULL || (S->sortedCount == S->length && S->length == S->count)) {
+    return; // already sorted and compact
+  }
+  int* a = S->store.items;
+  qsort(a + S->sortedCount, S->length - S->sortedCount, sizeof(int), compareInts); // sort the appended tail
+
+  int capacity = S->count + S->count / 2 + 8;
+  int* merged = malloc(sizeof(int) * capacity);
+  int n = 0;
+  int i = 0;
+  int j = S->sortedCount;
+  while (i < S->sortedCount || j < S->length) { // merge the sorted prefix with the sorted tail
+    int x;
+    if (j >= S->length || (i < S->sortedCount && a[i] <= a[j])) {
+      x = a[i++];
+    }
+    else {
+      x = a[j++];
+    }
+    if ((n > 0 && merged[n - 1] == x) || findSlot(S, x) < 0) { // skip duplicates and deleted neighbors
+      continue;
+    }
+    merged[n++] = x;
+  }
+
+  free(a);
+  S->store.items = merged;
+  S->capacity = capacity;
+  S->length = n;
+  S->sortedCount = n;
+  if (S->slotsUsed > S->count * 2) { // if the index is mostly deleted slots, rebuild it
+    rebuildSlots(S);
+  }
+}
+
+/**
+ * grow method that makes room for at least one more entry in the array
+ *
+ * @param - S - the NeighborSet
+ */
+static void grow(NeighborSet S) {
+  if (S->capacity == 0) { // move the inline neighbors to the heap
+    int* a = malloc(sizeof(int) * NS_INLINE * 2);
+    memcpy(a, S->store.inlineItems, sizeof(int) * S->length);
+    S->store.items = a;
+    S->capacity = NS_INLINE * 2;
+  }
+  else {
+    S->capacity *= 2;
+    S->store.items = realloc(S->store.items, sizeof(int) * S->capacity);
+  }
+}
+
+/**
+ * shrink method that moves a small set back into the inline array
+ *
+ * @param - S - the NeighborSet
+ */
+static void shrink(NeighborSet S) {
+  int* a = S->store.items;
+  memcpy(S->store.inlineItems, a, sizeof(int) * S->count);
+  free(a);
+  S->capacity = 0;
+}
+
+/*** Constructors-Destructors ***/
+
+/**
+ * initNeighborSet method that makes S an empty set
+ *
+ * @param - S - the NeighborSet
+ */
+void initNeighborSet(NeighborSet S) {
+  S->count = 0;
+  S->length = 0;
+  S->capacity = 0;
+  S->sortedCount = 0;
+  S->slots = NULL;
+  S->slotCount = 0;
+  S->slotsUsed = 0;
+}
+
+/**
+ * freeNeighborSet method that frees the heap memory used by S and makes it an empty set
+ *
+ * @param - S - the NeighborSet
+ */
+void freeNeighborSet(NeighborSet S) {
+  if (S->capacity > 0) { // borrowed arrays belong to someone else
+    free(S->store.items);
+  }
+  free(S->slots);
+  initNeighborSet(S);
+}
+
+/*** Access functions ***/
+
+/**
+ * neighborCount method that returns the number of neighbors in S
+ *
+ * @param - S - the NeighborSet
+ * @return - count
+ */
+int neighborCount(NeighborSet S) {
+  return S->count;
+}
+
+/**
+ * hasNeighbor method that returns 1 if x is in S, otherwise 0. O(1) for hashed sets and
+ * O(log count) otherwise
+ *
+ * @param - S - the NeighborSet
+ * @param - x - the neighbor
+ * @return - 1 or 0
+ */
+int hasNeighbor(NeighborSet S, int x) {
+  if (S->slots != NULL) {
+    return findSlot(S, x) >= 0;
+  }
+  const int* a = itemsOf(S);
+  int i = lowerBound(a, S->count, x);
+  return i < S->count && a[i] == x;
+}
+
+/**
+ * sortedNeighbors method that returns the neighbors of S in ascending order
+ *
+ * @param - S - the NeighborSet
+ * @return - an array of neighborCount(S) values
+ */
+const int* sortedNeighbors(NeighborSet S) {
+  normalize(S);
+  return itemsOf(S);
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * insertNeighbor method that adds x to S
+ *
+ * @param - S - the NeighborSet
+ * @param - x - the neighbor
+ * @return - 1 if x was added, 0 if x was already in S
+ */
+int insertNeighbor(NeighborSet S, int x) {
+  ownItems(S);
+  if (S->slots != NULL) { // hashed: append x and let the next sortedNeighbors put it in place
+    if (findSlot(S, x) >= 0) {
+      return 0;
+    }
+    if (S->length == S->capacity) {
+      if (S->length - S->count > S->count / 2) { // if many entries are deleted, compact instead of growing
+        normalize(S);
+      }
+      if (S->length == S->capacity) {
+        grow(S);
+      }
+    }
+    if ((S->slotsUsed + 1) * 4 > S->slotCount * 3) { // keep the load factor below 3/4
+      normalize(S);
+      S->count++; // count x so rebuildSlots sizes the index for it
+      rebuildSlots(S);
+      S->count--;
+    }
+    placeInSlots(S, x);
+    int* a = S->store.items;
+    if (S->sortedCount == S->length && (S->length == 0 || a[S->length - 1] < x)) {
+      S->sortedCount++; // appending in ascending order keeps the array sorted
+    }
+    a[S->length++] = x;
+    S->count++;
+    return 1;
+  }
+
+  int* a = itemsOf(S);
+  int i = lowerBound(a, S->count, x);
+  if (i < S->count && a[i] == x) {
+    return 0;
+  }
+  if (S->count == (S->capacity == 0 ? NS_INLINE : S->capacity)) {
+    grow(S);
+    a = itemsOf(S);
+  }
+  memmove(a + i + 1, a + i, sizeof(int) * (S->count - i)); // shift the larger neighbors over by one
+  a[i] = x;
+  S->count++;
+  S->length = S->count;
+  S->sortedCount = S->count;
+  if (S->count > NS_HASH_THRESHOLD) { // large sets get a hash index
+    rebuildSlots(S);
+  }
+  return 1;
+}
+
+/**
+ * removeNeighbor method that removes x from S
+ *
+ * @param - S - the NeighborSet
+ * @param - x - the neighbor
+ * @return - 1 if x was removed, 0 if x wasn't in S
+ */
+int removeNeighbor(NeighborSet S, int x) {
+  ownItems(S);
+  if (S->slots != NULL) { // hashed: only the index is updated, normalize drops the array entry later
+    int slot = findSlot(S, x);
+    if (slot < 0) {
+      return 0;
+    }
+    S->slots[slot] = DELETED_SLOT;
+    S->count--;
+    if (S->count < NS_HASH_THRESHOLD / 2) { // small enough to go back to a plain sorted array
+      normalize(S);
+      free(S->slots);
+      S->slots = NULL;
+      S->slotCount = 0;
+      S->slotsUsed = 0;
+    }
+    return 1;
+  }
+
+  int* a = itemsOf(S);
+  int i = lowerBound(a, S->count, x);
+  if (i >= S->count || a[i] != x) {
+    return 0;
+  }
+  memmove(a + i, a + i + 1, sizeof(int) * (S->count - i - 1)); // shift the larger neighbors back by one
+  S->count--;
+  S->length = S->count;
+  S->sortedCount = S->count;
+  if (S->capacity != 0 && S->count <= NS_INLINE / 2) { // small enough to go back to the inline array
+    shrink(S);
+  }
+  return 1;
+}
+
+/**
+ * setSortedNeighbors method that fills an empty set with an already sorted array of distinct neighbors
+ *
+ * @param - S - the NeighborSet
+ * @param - sorted - the neighbors in strictly ascending order
+ * @param - n - the number of neighbors
+ */
+void setSortedNeighbors(NeighborSet S, const int* sorted, int n) {
+  if (n > NS_INLINE) { // too many to store inline, so allocate an array of exactly n
+    S->store.items = malloc(sizeof(int) * n);
+    S->capacity = n;
+  }
+  memcpy(itemsOf(S), sorted, sizeof(int) * n);
+  S->count = n;
+  S->length = n;
+  S->sortedCount = n;
+  if (n > NS_HASH_THRESHOLD) { // large sets get a hash index
+    rebuildSlots(S);
+  }
+}
+
+/**
+ * borrowSortedNeighbors method that makes an empty set hold an already sorted array of distinct neighbors
+ * without copying it. Lookups binary search the borrowed array, and the first insert or remove copies it.
+ * A set small enough to be inline copies the neighbors straight away
+ *
+ * @param - S - the NeighborSet
+ * @param - sorted - the neighbors in strictly ascending order
+ * @param - n - the number of neighbors
+ */
+void borrowSortedNeighbors(NeighborSet S, const int* sorted, int n) {
+  if (n <= NS_INLINE) { // small sets are cheaper to copy inline than to point at
+    setSortedNeighbors(S, sorted, n);
+    return;
+  }
+  S->store.items = (int*) sorted; // never written through while capacity is -1
+  S->capacity = -1;
+  S->count = n;
+  S->length = n;
+  S->sortedCount = n;
+}
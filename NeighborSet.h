@@ -0,0 +1,66 @@
+/************************************************************
+ * NeighborSet.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef NEIGHBORSET_H
+#define NEIGHBORSET_H
+
+#define NS_INLINE 4 // sets with at most this many neighbors are stored inside the NeighborSetObj itself
+#define NS_HASH_THRESHOLD 256 // sets with more neighbors than this also keep a hash index for lookups
+
+// A set of vertices that adapts its storage to its size:
+// - up to NS_INLINE neighbors live in a sorted array inside the struct (no heap memory at all)
+// - above that they live in a sorted heap array, searched with binary search
+// - above NS_HASH_THRESHOLD a hash index is added; inserts are appended unsorted and deletes
+//   only touch the hash, and the array is sorted again the next time it is iterated
+// - a set can also borrow a sorted array it doesn't own (such as part of a memory-mapped file);
+//   it is only read until the first insert or remove, which copies it first
+// The fields are private; use the functions below.
+typedef struct NeighborSetObj {
+  int count; // the number of neighbors in the set
+  int length; // the number of entries in items (can include deleted and unsorted entries while hashed)
+  int capacity; // the capacity of the heap array (0 while the neighbors are stored inline, -1 while borrowed)
+  int sortedCount; // items[0 .. sortedCount) is sorted
+  union {
+    int inlineItems[NS_INLINE]; // the neighbors while capacity is 0
+    int* items; // the neighbors while capacity is not 0 (read-only while borrowed)
+  } store;
+  int* slots; // open addressing hash index (NULL unless the set is above NS_HASH_THRESHOLD)
+  int slotCount; // the number of slots (a power of 2)
+  int slotsUsed; // the number of slots that are full or deleted
+} NeighborSetObj;
+
+typedef NeighborSetObj* NeighborSet;
+
+// Constructors-Destructors ---------------------------------------------------
+void initNeighborSet(NeighborSet S); // makes S an empty set
+
+void freeNeighborSet(NeighborSet S); // frees all heap memory used by S and makes it an empty set
+
+
+// Access functions -----------------------------------------------------------
+int neighborCount(NeighborSet S); // Returns the number of neighbors in S.
+
+int hasNeighbor(NeighborSet S, int x); // Returns 1 if x is in S, otherwise returns 0.
+
+const int* sortedNeighbors(NeighborSet S); // Returns the neighbors in S as an ascending array of
+// neighborCount(S) values. The array stays valid until S is changed.
+
+
+// Manipulation procedures ----------------------------------------------------
+int insertNeighbor(NeighborSet S, int x); // Adds x to S. Returns 1 if x was added, and 0 if x
+// was already in S.
+
+int removeNeighbor(NeighborSet S, int x); // Removes x from S. Returns 1 if x was removed, and 0
+// if x wasn't in S.
+
+void setSortedNeighbors(NeighborSet S, const int* sorted, int n); // Makes S hold the n values in
+// sorted in one step, without any per-neighbor searching.
+// Precondition: S is empty and sorted is strictly ascending.
+
+void borrowSortedNeighbors(NeighborSet S, const int* sorted, int n); // Makes S hold the n values
+// in sorted without copying them (up to NS_INLINE of them are copied inline instead). sorted
+// must stay valid until S is freed; S copies it before the first change, so it is never written to.
+// Precondition: S is empty and sorted is strictly ascending.
+
+#endif
@@ -0,0 +1,288 @@
+/************************************************************
+ * OrderList.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in OrderList.h
+ ************************************************************/
+#include <stdlib.h>
+#include "OrderList.h"
+
+#define KEY_LIMIT (1LL << 62) // every key is in (0, KEY_LIMIT)
+#define KEY_SPACING (1LL << 32) // the gap placeLast leaves after the last key
+
+/**
+ * OrderListObj struct that keeps the positions in a circular doubly linked list of slots, with slot
+ * capacity as the sentinel that is both before the first and after the last position
+ */
+struct OrderListObj {
+  int capacity; // the number of items
+  int placed; // the number of placed items
+  long long* slotKeys; // the key of each slot
+  int* slotNext; // the next slot in the order
+  int* slotPrev; // the previous slot in the order
+  int* slotItems; // the item in each slot
+  int* itemSlots; // the slot of each item (-1 if it isn't placed)
+  int* freeSlots; // a stack of the slots that aren't in use
+  int freeCount;
+};
+
+/**
+ * SlotKey typedef struct used to sort slots by key
+ */
+typedef struct SlotKey {
+  long long key;
+  int slot;
+} SlotKey;
+
+/**
+ * compareSlotKeys method used by qsort to sort SlotKeys by key
+ */
+static int compareSlotKeys(const void* a, const void* b) {
+  long long x = ((const SlotKey*) a)->key;
+  long long y = ((const SlotKey*) b)->key;
+  return (x > y) - (x < y);
+}
+
+/**
+ * respread method that gives the positions evenly spaced keys, keeping their order
+ *
+ * @param - L - the OrderList
+ */
+static void respread(OrderList L) {
+  long long spacing = KEY_LIMIT / (L->placed + 2);
+  long long key = spacing;
+  for (int s = L->slotNext[L->capacity]; s != L->capacity; s = L->slotNext[s]) {
+    L->slotKeys[s] = key;
+    key += spacing;
+  }
+}
+
+/**
+ * newSlot method that links a new slot holding x in right after slot prev, with the given key
+ */
+static void newSlot(OrderList L, int prev, int x, long long key) {
+  int s = L->freeSlots[--L->freeCount];
+  int next = L->slotNext[prev];
+  L->slotKeys[s] = key;
+  L->slotItems[s] = x;
+  L->slotPrev[s] = prev;
+  L->slotNext[s] = next;
+  L->slotNext[prev] = s;
+  L->slotPrev[next] = s;
+  L->itemSlots[x] = s;
+  L->placed++;
+}
+
+/**
+ * keyAfter method that returns a key for a new position right after slot prev, spreading the keys out
+ * first if there is no room
+ */
+static long long keyAfter(OrderList L, int prev) {
+  for (;;) {
+    long long low = prev == L->capacity ? 0 : L->slotKeys[prev];
+    int next = L->slotNext[prev];
+    long long high = next == L->capacity ? KEY_LIMIT : L->slotKeys[next];
+    if (high - low >= 2) {
+      long long gap = (high - low) / 2;
+      return low + (next == L->capacity && gap > KEY_SPACING ? KEY_SPACING : gap); // leave room at the end for more appends
+    }
+    respread(L); // a single respread always leaves room, since there are fewer than 2^31 positions
+  }
+}
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newOrderList method that returns an empty OrderList for the items 0 .. capacity - 1
+ *
+ * @param - capacity - the number of items
+ * @return - the new OrderList
+ */
+OrderList newOrderList(int capacity) {
+  OrderList L = malloc(sizeof(struct OrderListObj));
+  L->capacity = capacity;
+  L->slotKeys = malloc(sizeof(long long) * (capacity + 1));
+  L->slotNext = malloc(sizeof(int) * (capacity + 1));
+  L->slotPrev = malloc(sizeof(int) * (capacity + 1));
+  L->slotItems = malloc(sizeof(int) * (capacity + 1));
+  L->itemSlots = malloc(sizeof(int) * (capacity + 1));
+  L->freeSlots = malloc(sizeof(int) * (capacity + 1));
+  clearOrder(L);
+  return L;
+}
+
+/**
+ * freeOrderList method that frees the heap memory used by the OrderList
+ *
+ * @param - pL - the pointer to the OrderList
+ */
+void freeOrderList(OrderList* pL) {
+  OrderList L = *pL;
+  free(L->slotKeys);
+  free(L->slotNext);
+  free(L->slotPrev);
+  free(L->slotItems);
+  free(L->itemSlots);
+  free(L->freeSlots);
+  free(L);
+  *pL = NULL;
+}
+
+/*** Access functions ***/
+
+/**
+ * orderKey method that returns the key of placed item x
+ */
+long long orderKey(OrderList L, int x) {
+  return L->slotKeys[L->itemSlots[x]];
+}
+
+/**
+ * firstPlaced method that returns the first item in the order, or -1 if nothing is placed
+ */
+int firstPlaced(OrderList L) {
+  int s = L->slotNext[L->capacity];
+  return s == L->capacity ? -1 : L->slotItems[s];
+}
+
+/**
+ * nextPlaced method that returns the item right after placed item x, or -1 if x is last
+ */
+int nextPlaced(OrderList L, int x) {
+  int s = L->slotNext[L->itemSlots[x]];
+  return s == L->capacity ? -1 : L->slotItems[s];
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * clearOrder method that unplaces every item
+ *
+ * @param - L - the OrderList
+ */
+void clearOrder(OrderList L) {
+  L->placed = 0;
+  L->slotNext[L->capacity] = L->capacity; // only the sentinel is left
+  L->slotPrev[L->capacity] = L->capacity;
+  for (int x = 0; x < L->capacity; x++) {
+    L->itemSlots[x] = -1;
+  }
+  L->freeCount = 0;
+  for (int s = L->capacity - 1; s >= 0; s--) { // slot 0 is handed out first
+    L->freeSlots[L->freeCount++] = s;
+  }
+}
+
+/**
+ * placeLast method that places item x after every other item
+ *
+ * @param - L - the OrderList
+ * @param - x - the item
+ */
+void placeLast(OrderList L, int x) {
+  int last = L->slotPrev[L->capacity];
+  newSlot(L, last, x, keyAfter(L, last));
+}
+
+/**
+ * placeAfter method that places item y right after placed item x
+ *
+ * @param - L - the OrderList
+ * @param - x - the item already placed
+ * @param - y - the item to place
+ */
+void placeAfter(OrderList L, int x, int y) {
+  int prev = L->itemSlots[x];
+  long long key = keyAfter(L, prev);
+  newSlot(L, prev, y, key);
+}
+
+/**
+ * placeAllAfter method that places the n items right after placed item x, in the order given. The n new
+ * positions split the gap after x evenly, so the keys are spread out at most once however many items there are
+ *
+ * @param - L - the OrderList
+ * @param - x - the item already placed
+ * @param - items - the items to place
+ * @param - n - the number of items
+ */
+void placeAllAfter(OrderList L, int x, const int* items, int n) {
+  int first = L->itemSlots[x];
+  int next = L->slotNext[first];
+  long long low = L->slotKeys[first];
+  long long high = next == L->capacity ? KEY_LIMIT : L->slotKeys[next];
+  int prev = first;
+  for (int i = 0; i < n; i++) { // link every new position in first, with a key filled in below
+    newSlot(L, prev, items[i], 0);
+    prev = L->itemSlots[items[i]];
+  }
+  if ((high - low) / (n + 1) < 1) {
+    respread(L); // gives the new positions keys too, since they are linked in
+    return;
+  }
+  long long step = (high - low) / (n + 1);
+  if (next == L->capacity && step > KEY_SPACING) { // leave room at the end for more appends
+    step = KEY_SPACING;
+  }
+  long long key = low;
+  for (int s = L->slotNext[first]; s != next; s = L->slotNext[s]) {
+    key += step;
+    L->slotKeys[s] = key;
+  }
+}
+
+/**
+ * unplace method that removes placed item x from the order
+ *
+ * @param - L - the OrderList
+ * @param - x - the item
+ */
+void unplace(OrderList L, int x) {
+  int s = L->itemSlots[x];
+  L->slotNext[L->slotPrev[s]] = L->slotNext[s];
+  L->slotPrev[L->slotNext[s]] = L->slotPrev[s];
+  L->itemSlots[x] = -1;
+  L->freeSlots[L->freeCount++] = s;
+  L->placed--;
+}
+
+/**
+ * permuteOrder method that moves the n placed items among the positions they occupy so they come in
+ * the order given. Only the items are moved between the slots, so no other item's key changes
+ *
+ * @param - L - the OrderList
+ * @param - items - the items in their new order
+ * @param - n - the number of items
+ */
+void permuteOrder(OrderList L, const int* items, int n) {
+  SlotKey* slots = malloc(sizeof(SlotKey) * (n + 1));
+  for (int i = 0; i < n; i++) {
+    slots[i].slot = L->itemSlots[items[i]];
+    slots[i].key = L->slotKeys[slots[i].slot];
+  }
+  qsort(slots, n, sizeof(SlotKey), compareSlotKeys);
+  for (int i = 0; i < n; i++) { // the i-th item takes the i-th position
+    L->slotItems[slots[i].slot] = items[i];
+    L->itemSlots[items[i]] = slots[i].slot;
+  }
+  free(slots);
+}
+
+/**
+ * sortPlaced method that sorts the n placed items into their order
+ *
+ * @param - L - the OrderList
+ * @param - items - the items
+ * @param - n - the number of items
+ */
+void sortPlaced(OrderList L, int* items, int n) {
+  SlotKey* slots = malloc(sizeof(SlotKey) * (n + 1));
+  for (int i = 0; i < n; i++) {
+    slots[i].slot = L->itemSlots[items[i]];
+    slots[i].key = L->slotKeys[slots[i].slot];
+  }
+  qsort(slots, n, sizeof(SlotKey), compareSlotKeys);
+  for (int i = 0; i < n; i++) {
+    items[i] = L->slotItems[slots[i].slot];
+  }
+  free(slots);
+}
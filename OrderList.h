@@ -0,0 +1,52 @@
+/************************************************************
+ * OrderList.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef ORDERLIST_H
+#define ORDERLIST_H
+
+// A total order over some of the items 0 .. capacity - 1 that answers "does x come before y" in
+// constant time. Every placed item sits in a position that has an integer key, and x comes before y
+// exactly when orderKey(x) < orderKey(y). Keys are spaced out so new positions can usually be made
+// between two neighbors without touching anything else; when a gap runs out, every key is spread out
+// again.
+
+// private OrderListObj type
+typedef struct OrderListObj* OrderList;
+
+// Constructors-Destructors ---------------------------------------------------
+OrderList newOrderList(int capacity); // returns an empty OrderList for the items 0 .. capacity - 1
+
+void freeOrderList(OrderList* pL); // frees all heap memory associated with its OrderList* argument,
+// and sets *pL to NULL
+
+
+// Access functions -----------------------------------------------------------
+long long orderKey(OrderList L, int x); // Returns the key of placed item x.
+
+int firstPlaced(OrderList L); // Returns the first item in the order, or -1 if nothing is placed.
+
+int nextPlaced(OrderList L, int x); // Returns the item right after placed item x, or -1 if x is last.
+
+void sortPlaced(OrderList L, int* items, int n); // Sorts the n placed items in items into their order.
+
+
+// Manipulation procedures ----------------------------------------------------
+void clearOrder(OrderList L); // Unplaces every item.
+
+void placeLast(OrderList L, int x); // Places item x after every other item.
+// Precondition: x isn't placed.
+
+void placeAfter(OrderList L, int x, int y); // Places item y right after placed item x.
+// Precondition: y isn't placed.
+
+void placeAllAfter(OrderList L, int x, const int* items, int n); // Places the n items right after
+// placed item x, in the order given, spreading the keys out at most once. Precondition: none of the
+// items is placed.
+
+void unplace(OrderList L, int x); // Removes placed item x from the order.
+
+void permuteOrder(OrderList L, const int* items, int n); // Moves the n placed items among the
+// positions they already occupy so they come in the order given, without moving any other item.
+
+#endif
@@ -0,0 +1,313 @@
+/************************************************************
+ * Packed.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Packed.h
+ ************************************************************/
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "Packed.h"
+
+#if defined(__x86_64__) || defined(__i386__)
+#include <immintrin.h>
+#define PACKED_X86 1
+#endif
+
+#define PACKED_PADDING 16 // zero bytes after each stream, so a 16 byte load from any gap stays inside it
+
+/**
+ * PackedLists typedef struct that holds the neighbor lists of every vertex in one direction. The list of
+ * vertex v starts at bytes[offsets[v]] with its (degrees[v] + 3) / 4 control bytes, and its gaps follow
+ */
+typedef struct PackedLists {
+  size_t* offsets; // where each vertex's list starts in bytes
+  int* degrees; // the number of neighbors in each list
+  unsigned char* bytes; // every list, one after another
+  size_t length; // the number of bytes in use
+  size_t capacity; // the number of bytes allocated
+  int count; // the number of vertices packed so far
+} PackedLists;
+
+/**
+ * PackedObj struct that holds the outgoing and incoming neighbor lists
+ */
+struct PackedObj {
+  int numVertices;
+  int maxDegree; // the largest list in either direction
+  PackedLists out; // the outgoing neighbors
+  PackedLists in; // the incoming neighbors
+  void (*decode)(const unsigned char*, const unsigned char*, int, int*); // the fastest decoder the CPU has
+};
+
+static unsigned char shuffleTable[256][16]; // for each control byte, where each byte of the four gaps comes from
+static unsigned char groupLengths[256]; // for each control byte, the number of bytes its four gaps take
+static bool tablesReady = false;
+
+/**
+ * buildTables method that fills in shuffleTable and groupLengths the first time a Packed is made
+ */
+static void buildTables(void) {
+  if (tablesReady) {
+    return;
+  }
+  for (int c = 0; c < 256; c++) {
+    int at = 0;
+    for (int k = 0; k < 4; k++) {
+      int length = ((c >> (2 * k)) & 3) + 1;
+      for (int b = 0; b < 4; b++) { // byte b of gap k is the next input byte, or zero past its length
+        shuffleTable[c][4 * k + b] = b < length ? (unsigned char) at++ : 0x80;
+      }
+    }
+    groupLengths[c] = (unsigned char) at;
+  }
+  tablesReady = true;
+}
+
+/**
+ * decodeFrom method that decodes neighbors first .. n - 1 of a list one at a time
+ *
+ * @param - control - the list's control bytes
+ * @param - data - where the gap of neighbor first starts
+ * @param - first - the first neighbor to decode
+ * @param - n - the number of neighbors in the list
+ * @param - last - the neighbor before neighbor first (0 if first is 0)
+ * @param - out - where the neighbors go
+ */
+static void decodeFrom(const unsigned char* control, const unsigned char* data, int first, int n, int last, int* out) {
+  for (int i = first; i < n; i++) {
+    int length = ((control[i >> 2] >> (2 * (i & 3))) & 3) + 1;
+    uint32_t gap = 0;
+    for (int b = 0; b < length; b++) {
+      gap |= (uint32_t) data[b] << (8 * b);
+    }
+    data += length;
+    last += (int) gap;
+    out[i] = last;
+  }
+}
+
+/**
+ * decodeScalar method that decodes the n neighbors of a list one at a time
+ */
+static void decodeScalar(const unsigned char* control, const unsigned char* data, int n, int* out) {
+  decodeFrom(control, data, 0, n, 0, out);
+}
+
+#ifdef PACKED_X86
+/**
+ * decodeSSSE3 method that decodes the n neighbors of a list four at a time: one shuffle widens the four gaps
+ * to 32 bits, two shifted adds turn them into running sums, and adding the last neighbor of the previous group
+ * gives the neighbors. The neighbors left over after the last full group are decoded one at a time
+ */
+__attribute__((target("ssse3")))
+static void decodeSSSE3(const unsigned char* control, const unsigned char* data, int n, int* out) {
+  __m128i previous = _mm_setzero_si128(); // the last neighbor decoded, in every lane
+  int i = 0;
+  for (; i + 4 <= n; i += 4) {
+    int c = control[i >> 2];
+    __m128i gaps = _mm_shuffle_epi8(_mm_loadu_si128((const __m128i*) data),
+        _mm_loadu_si128((const __m128i*) shuffleTable[c]));
+    gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 4));
+    gaps = _mm_add_epi32(gaps, _mm_slli_si128(gaps, 8));
+    __m128i values = _mm_add_epi32(gaps, previous);
+    _mm_storeu_si128((__m128i*) (out + i), values);
+    previous = _mm_shuffle_epi32(values, 0xFF);
+    data += groupLengths[c];
+  }
+  decodeFrom(control, data, i, n, i > 0 ? out[i - 1] : 0, out);
+}
+#endif
+
+/**
+ * initLists method that makes L an empty set of lists for numVertices vertices
+ */
+static void initLists(PackedLists* L, int numVertices) {
+  L->offsets = malloc(sizeof(size_t) * ((size_t) numVertices + 1));
+  L->degrees = malloc(sizeof(int) * numVertices);
+  L->capacity = 4096;
+  L->bytes = malloc(L->capacity);
+  L->length = 0;
+  L->count = 0;
+}
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newPacked method that returns a Packed with room for numVertices vertices and no lists yet
+ *
+ * @param - numVertices - the number of vertices
+ * @return - the new Packed
+ */
+Packed newPacked(int numVertices) {
+  buildTables();
+  Packed P = malloc(sizeof(struct PackedObj));
+  P->numVertices = numVertices;
+  P->maxDegree = 0;
+  initLists(&P->out, numVertices);
+  initLists(&P->in, numVertices);
+  P->decode = decodeScalar;
+#ifdef PACKED_X86
+  __builtin_cpu_init();
+  if (__builtin_cpu_supports("ssse3")) {
+    P->decode = decodeSSSE3;
+  }
+#endif
+  return P;
+}
+
+/**
+ * freePacked method that frees the heap memory used by the Packed
+ *
+ * @param - pP - the pointer to the Packed
+ */
+void freePacked(Packed* pP) {
+  Packed P = *pP;
+  free(P->out.offsets);
+  free(P->out.degrees);
+  free(P->out.bytes);
+  free(P->in.offsets);
+  free(P->in.degrees);
+  free(P->in.bytes);
+  free(P);
+  *pP = NULL;
+}
+
+/*** Access functions ***/
+
+/**
+ * packedDegree method that returns the number of outgoing or incoming neighbors of vertex v
+ */
+int packedDegree(Packed P, bool forward, int v) {
+  return (forward ? &P->out : &P->in)->degrees[v];
+}
+
+/**
+ * maxPackedDegree method that returns the largest number of neighbors any list has
+ */
+int maxPackedDegree(Packed P) {
+  return P->maxDegree;
+}
+
+/**
+ * packedBytes method that returns the heap memory P uses
+ */
+size_t packedBytes(Packed P) {
+  size_t perVertex = sizeof(size_t) * ((size_t) P->numVertices + 1) + sizeof(int) * (size_t) P->numVertices;
+  return sizeof(struct PackedObj) + 2 * perVertex + P->out.capacity + P->in.capacity;
+}
+
+/**
+ * unpackNeighbors method that decodes the outgoing or incoming neighbors of v into out
+ *
+ * @param - P - the Packed
+ * @param - forward - true for the outgoing neighbors, false for the incoming ones
+ * @param - v - the vertex (0-based)
+ * @param - out - where the neighbors go, in ascending order
+ * @return - the number of neighbors
+ */
+int unpackNeighbors(Packed P, bool forward, int v, int* out) {
+  PackedLists* L = forward ? &P->out : &P->in;
+  int n = L->degrees[v];
+  const unsigned char* control = L->bytes + L->offsets[v];
+  P->decode(control, control + (n + 3) / 4, n, out);
+  return n;
+}
+
+/**
+ * startNeighbors method that points c at the first outgoing or incoming neighbor of v
+ */
+void startNeighbors(Packed P, bool forward, int v, PackedCursor* c) {
+  PackedLists* L = forward ? &P->out : &P->in;
+  c->data = L->offsets[v] + (L->degrees[v] + 3) / 4;
+  c->index = 0;
+  c->last = 0;
+}
+
+/**
+ * nextNeighbor method that returns the neighbor c points at and moves c past it
+ *
+ * @param - P - the Packed
+ * @param - forward - true for the outgoing neighbors, false for the incoming ones
+ * @param - v - the vertex (0-based) whose list c walks through
+ * @param - c - the cursor
+ * @return - the neighbor, or -1 if there are none left
+ */
+int nextNeighbor(Packed P, bool forward, int v, PackedCursor* c) {
+  PackedLists* L = forward ? &P->out : &P->in;
+  if (c->index == L->degrees[v]) {
+    return -1;
+  }
+  int length = ((L->bytes[L->offsets[v] + (c->index >> 2)] >> (2 * (c->index & 3))) & 3) + 1;
+  const unsigned char* data = L->bytes + c->data;
+  uint32_t gap = 0;
+  for (int b = 0; b < length; b++) {
+    gap |= (uint32_t) data[b] << (8 * b);
+  }
+  c->data += length;
+  c->index++;
+  c->last += (int) gap;
+  return c->last;
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * packNeighbors method that encodes the n values in sorted as the list of the next vertex in one direction
+ *
+ * @param - P - the Packed
+ * @param - forward - true for the outgoing neighbors, false for the incoming ones
+ * @param - sorted - the neighbors, strictly ascending
+ * @param - n - the number of neighbors
+ */
+void packNeighbors(Packed P, bool forward, const int* sorted, int n) {
+  PackedLists* L = forward ? &P->out : &P->in;
+  size_t controlLength = (size_t) (n + 3) / 4;
+  size_t needed = L->length + controlLength + 4 * (size_t) n + PACKED_PADDING; // the longest the list can be
+  if (needed > L->capacity) {
+    while (L->capacity < needed) {
+      L->capacity *= 2;
+    }
+    L->bytes = realloc(L->bytes, L->capacity);
+  }
+
+  int v = L->count++;
+  L->offsets[v] = L->length;
+  L->degrees[v] = n;
+  if (n > P->maxDegree) {
+    P->maxDegree = n;
+  }
+  unsigned char* control = L->bytes + L->length;
+  unsigned char* data = control + controlLength;
+  memset(control, 0, controlLength);
+  int last = 0;
+  for (int i = 0; i < n; i++) {
+    uint32_t gap = (uint32_t) (sorted[i] - last);
+    int length = gap < (1u << 8) ? 1 : gap < (1u << 16) ? 2 : gap < (1u << 24) ? 3 : 4;
+    control[i >> 2] |= (unsigned char) ((length - 1) << (2 * (i & 3)));
+    for (int b = 0; b < length; b++) {
+      *data++ = (unsigned char) (gap >> (8 * b));
+    }
+    last = sorted[i];
+  }
+  L->length = data - L->bytes;
+}
+
+/**
+ * finishLists method that shrinks the bytes of L to what is in use, plus zeroed padding
+ */
+static void finishLists(PackedLists* L) {
+  L->offsets[L->count] = L->length;
+  L->capacity = L->length + PACKED_PADDING;
+  L->bytes = realloc(L->bytes, L->capacity);
+  memset(L->bytes + L->length, 0, PACKED_PADDING);
+}
+
+/**
+ * finishPacked method that gives back the room the byte streams were grown by
+ *
+ * @param - P - the Packed
+ */
+void finishPacked(Packed P) {
+  finishLists(&P->out);
+  finishLists(&P->in);
+}
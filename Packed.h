@@ -0,0 +1,65 @@
+/************************************************************
+ * Packed.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef PACKED_H
+#define PACKED_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// A compressed, read-only copy of the outgoing and incoming neighbors of every vertex of a digraph.
+// Each sorted neighbor list is gap encoded (the first neighbor, then the difference between each
+// neighbor and the one before it) and the gaps are stored with stream-VByte: one control byte per
+// group of four gaps, holding the byte length (1 to 4) of each, followed by the gaps' bytes with
+// the leading zero bytes left out. A list is decoded four neighbors at a time with SSSE3 (one
+// shuffle to widen the gaps and a prefix sum to turn them back into neighbors) when the CPU has it,
+// and one at a time everywhere else. Sparse graphs whose neighbors are numbered close together
+// take one or two bytes per edge in each direction instead of four.
+
+// private PackedObj type
+typedef struct PackedObj* Packed;
+
+// The position of a walk through one neighbor list, for walks that look at one neighbor at a time
+typedef struct PackedCursor {
+  size_t data; // where the bytes of the next gap start
+  int index; // how many neighbors have been looked at
+  int last; // the last neighbor looked at (0 before the first)
+} PackedCursor;
+
+// Constructors-Destructors ---------------------------------------------------
+Packed newPacked(int numVertices); // returns a Packed with room for numVertices vertices and no
+// neighbor lists yet
+
+void freePacked(Packed* pP); // frees all heap memory associated with its Packed* argument,
+// and sets *pP to NULL
+
+
+// Access functions -----------------------------------------------------------
+int packedDegree(Packed P, bool forward, int v); // Returns the number of outgoing (forward) or
+// incoming neighbors of vertex v (0-based).
+
+int maxPackedDegree(Packed P); // Returns the largest number of neighbors any list has.
+
+size_t packedBytes(Packed P); // Returns the heap memory P uses.
+
+int unpackNeighbors(Packed P, bool forward, int v, int* out); // Decodes the outgoing or incoming
+// neighbors of v into out in ascending order and returns how many there are. out needs room for
+// packedDegree(P, forward, v) values.
+
+void startNeighbors(Packed P, bool forward, int v, PackedCursor* c); // Points c at the first
+// outgoing or incoming neighbor of v.
+
+int nextNeighbor(Packed P, bool forward, int v, PackedCursor* c); // Returns the neighbor c points
+// at and moves c past it, or -1 if every neighbor of v has been looked at.
+
+
+// Manipulation procedures ----------------------------------------------------
+void packNeighbors(Packed P, bool forward, const int* sorted, int n); // Encodes the n values in
+// sorted as the outgoing (forward) or incoming neighbors of the next vertex in that direction.
+// Precondition: the vertices are packed in order in each direction and sorted is strictly ascending.
+
+void finishPacked(Packed P); // Gives back the room the byte streams were grown by. Called once
+// every vertex has been packed in both directions.
+
+#endif
@@ -0,0 +1,777 @@
+/************************************************************
+ * ParallelSCC.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in ParallelSCC.h
+ *
+ * The SCCs are found in four phases, following the forward-backward (FW-BW) method with trimming:
+ * 1. Trim: every vertex with no incoming or no outgoing edges from the remaining vertices is an SCC
+ *    on its own. Removing it can expose more such vertices, so they are peeled off with worklists.
+ * 2. Giant SCC: on power-law graphs most of the remaining vertices are usually in one SCC. It is
+ *    found as the intersection of what a well connected pivot can reach (FW) and what can reach the
+ *    pivot (BW), with both searches expanding each level of the frontier across all threads.
+ * 3. Trim again, now that the giant SCC is gone.
+ * 4. Every remaining SCC lies entirely inside FW, inside BW or outside both, so each of those sets
+ *    (told apart by a color per vertex) is an independent subproblem. Subproblems are tasks in a
+ *    work-stealing pool: each one is split again with FW-BW on a single thread, and small ones (or
+ *    ones FW-BW doesn't split well) are finished with Tarjan's algorithm.
+ ************************************************************/
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <sched.h>
+#include <stdbool.h>
+#include <stdlib.h>
+#include <string.h>
+#include "ParallelSCC.h"
+
+#define UNLABELLED -1 // a vertex whose SCC hasn't been found yet
+#define CLAIMED -2 // a vertex that a thread is about to label
+#define FORWARD 1 // reached from the pivot
+#define BACKWARD 2 // reaches the pivot
+#define ON_STACK 4 // on the Tarjan stack of the task that owns the vertex
+
+#define PARALLEL_FRONTIER 1024 // smaller frontiers are expanded by a single thread
+#define SEQUENTIAL_CUTOFF 1024 // subproblems of at most this many vertices are finished with Tarjan
+#define POOR_SPLIT 8 // a part with more than size - size / POOR_SPLIT vertices is finished with Tarjan
+
+// Shared per-vertex values that other threads may change are read and written with relaxed atomics
+#define LOAD(p) __atomic_load_n((p), __ATOMIC_RELAXED)
+#define STORE(p, x) __atomic_store_n((p), (x), __ATOMIC_RELAXED)
+
+/**
+ * IntBuffer typedef struct that holds a growable array of ints owned by one thread
+ */
+typedef struct IntBuffer {
+  int* items;
+  int count;
+  int capacity;
+} IntBuffer;
+
+/**
+ * Task typedef struct that holds one subproblem: the vertices of one color
+ */
+typedef struct Task {
+  int color; // the color every vertex in the task has
+  bool sequential; // whether to go straight to Tarjan
+  int size; // the number of vertices
+  int vertices[]; // the vertices
+} Task;
+
+/**
+ * Deque typedef struct that holds the tasks waiting on one thread. The owner takes the newest task
+ * and the other threads steal the oldest
+ */
+typedef struct Deque {
+  pthread_mutex_t lock;
+  Task** tasks;
+  int head; // tasks[head .. tail) are waiting
+  int tail;
+  int capacity;
+} Deque;
+
+typedef struct Engine Engine;
+
+typedef void (*Job)(Engine* E, int t); // the work thread t does in one parallel step
+
+/**
+ * WorkerArg typedef struct that is handed to each worker thread
+ */
+typedef struct WorkerArg {
+  Engine* E;
+  int t; // the index of the thread
+} WorkerArg;
+
+/**
+ * Engine struct that holds the state shared by all the threads
+ */
+struct Engine {
+  Snapshot S; // the digraph
+  int n; // the number of vertices
+  int numThreads; // the number of threads, including the calling thread
+  int* comp; // the SCC of each vertex (UNLABELLED until found)
+  int* color; // the subproblem each unlabelled vertex is in
+  int* liveOut; // the number of outgoing neighbors left in the same subproblem (while trimming)
+  int* liveIn; // the number of incoming neighbors left in the same subproblem (while trimming)
+  unsigned char* flags; // FORWARD, BACKWARD and ON_STACK bits
+  int* order; // Tarjan discovery index of each vertex
+  int* low; // Tarjan lowlink of each vertex
+  size_t* cursors; // the index of the next neighbor to look at for each vertex on a DFS path
+  int numComponents; // the number of SCC ids handed out
+  int numColors; // the number of colors handed out
+  IntBuffer* buffers; // one scratch buffer per thread
+
+  int* renumber; // the final number of each SCC id (numVertices + 1 entries)
+
+  int* frontier; // the current level of a parallel search
+  int frontierSize;
+  int searchColor; // the color a parallel search stays inside
+  unsigned char searchBit; // FORWARD or BACKWARD
+
+  Deque* deques; // one task deque per thread
+  int pendingTasks; // tasks pushed but not yet finished
+
+  pthread_t* threads; // the worker threads (numThreads - 1 of them)
+  WorkerArg* args;
+  pthread_mutex_t lock; // protects job, generation, running and quit
+  pthread_cond_t start; // signalled when a new job is posted
+  pthread_cond_t done; // signalled when the last worker finishes a job
+  Job job; // the job being run
+  long generation; // incremented for every job posted
+  int running; // the number of workers still running the job
+  bool quit; // tells the workers to exit
+};
+
+/*** Helpers ***/
+
+/**
+ * pushInt method that appends x to B, growing it if needed
+ */
+static void pushInt(IntBuffer* B, int x) {
+  if (B->count == B->capacity) {
+    B->capacity = B->capacity == 0 ? 256 : B->capacity * 2;
+    B->items = realloc(B->items, sizeof(int) * B->capacity);
+  }
+  B->items[B->count++] = x;
+}
+
+/**
+ * rangeStart method that returns the first index of thread t's share of [0, n)
+ */
+static int rangeStart(Engine* E, int n, int t) {
+  return (int) ((long long) n * t / E->numThreads);
+}
+
+/**
+ * newComponent method that hands out a new SCC id
+ */
+static int newComponent(Engine* E) {
+  return __atomic_fetch_add(&E->numComponents, 1, __ATOMIC_RELAXED);
+}
+
+/**
+ * newColors method that hands out count new colors and returns the first
+ */
+static int newColors(Engine* E, int count) {
+  return __atomic_fetch_add(&E->numColors, count, __ATOMIC_RELAXED);
+}
+
+/**
+ * isLive method that returns whether v is unlabelled and in the subproblem with color c
+ */
+static bool isLive(Engine* E, int v, int c) {
+  return LOAD(&E->comp[v]) == UNLABELLED && LOAD(&E->color[v]) == c;
+}
+
+/*** Thread pool ***/
+
+/**
+ * workerMain method that runs every job posted to the pool on one worker thread until quit is set
+ */
+static void* workerMain(void* p) {
+  WorkerArg* arg = p;
+  Engine* E = arg->E;
+  long seen = 0; // the last generation this worker ran
+  while (true) {
+    pthread_mutex_lock(&E->lock);
+    while (E->generation == seen && !E->quit) {
+      pthread_cond_wait(&E->start, &E->lock);
+    }
+    if (E->quit) {
+      pthread_mutex_unlock(&E->lock);
+      return NULL;
+    }
+    seen = E->generation;
+    Job job = E->job;
+    pthread_mutex_unlock(&E->lock);
+
+    job(E, arg->t);
+
+    pthread_mutex_lock(&E->lock);
+    if (--E->running == 0) {
+      pthread_cond_signal(&E->done);
+    }
+    pthread_mutex_unlock(&E->lock);
+  }
+}
+
+/**
+ * runParallel method that runs job on every thread (the calling thread is thread 0) and waits for all
+ * of them to finish
+ */
+static void runParallel(Engine* E, Job job) {
+  pthread_mutex_lock(&E->lock);
+  E->job = job;
+  E->running = E->numThreads - 1;
+  E->generation++;
+  pthread_cond_broadcast(&E->start);
+  pthread_mutex_unlock(&E->lock);
+
+  job(E, 0);
+
+  pthread_mutex_lock(&E->lock);
+  while (E->running > 0) {
+    pthread_cond_wait(&E->done, &E->lock);
+  }
+  pthread_mutex_unlock(&E->lock);
+}
+
+/*** Phases 1 and 3: trimming ***/
+
+/**
+ * countLiveJob method that counts, for each unlabelled vertex in thread t's share, its incoming and
+ * outgoing neighbors in the same subproblem (ignoring self loops)
+ */
+static void countLiveJob(Engine* E, int t) {
+  Snapshot S = E->S;
+  for (int v = rangeStart(E, E->n, t); v < rangeStart(E, E->n, t + 1); v++) {
+    if (E->comp[v] != UNLABELLED) {
+      continue;
+    }
+    int c = E->color[v];
+    int outCount = 0;
+    for (size_t e = S->outOffsets[v]; e < S->outOffsets[v + 1]; e++) {
+      int w = S->outTargets[e];
+      outCount += w != v && isLive(E, w, c);
+    }
+    int inCount = 0;
+    for (size_t e = S->inOffsets[v]; e < S->inOffsets[v + 1]; e++) {
+      int w = S->inTargets[e];
+      inCount += w != v && isLive(E, w, c);
+    }
+    E->liveOut[v] = outCount;
+    E->liveIn[v] = inCount;
+  }
+}
+
+/**
+ * claim method that makes v a single vertex SCC, unless another thread got to it first
+ *
+ * @return - whether this thread labelled v
+ */
+static bool claim(Engine* E, int v) {
+  int expected = UNLABELLED;
+  if (!__atomic_compare_exchange_n(&E->comp[v], &expected, CLAIMED, false, __ATOMIC_RELAXED, __ATOMIC_RELAXED)) {
+    return false;
+  }
+  STORE(&E->comp[v], newComponent(E));
+  return true;
+}
+
+/**
+ * peelJob method that trims the vertices in thread t's share that have no live incoming or outgoing
+ * neighbors, then everything that trimming them exposes
+ */
+static void peelJob(Engine* E, int t) {
+  Snapshot S = E->S;
+  IntBuffer* stack = &E->buffers[t];
+  stack->count = 0;
+  for (int v = rangeStart(E, E->n, t); v < rangeStart(E, E->n, t + 1); v++) {
+    if ((LOAD(&E->liveOut[v]) == 0 || LOAD(&E->liveIn[v]) == 0) && claim(E, v)) {
+      pushInt(stack, v);
+    }
+  }
+  while (stack->count > 0) {
+    int x = stack->items[--stack->count];
+    int c = E->color[x];
+    for (size_t e = S->outOffsets[x]; e < S->outOffsets[x + 1]; e++) { // x no longer feeds its outgoing neighbors
+      int w = S->outTargets[e];
+      if (w != x && LOAD(&E->color[w]) == c && __atomic_sub_fetch(&E->liveIn[w], 1, __ATOMIC_RELAXED) == 0 && claim(E, w)) {
+        pushInt(stack, w);
+      }
+    }
+    for (size_t e = S->inOffsets[x]; e < S->inOffsets[x + 1]; e++) { // and no longer drains its incoming neighbors
+      int w = S->inTargets[e];
+      if (w != x && LOAD(&E->color[w]) == c && __atomic_sub_fetch(&E->liveOut[w], 1, __ATOMIC_RELAXED) == 0 && claim(E, w)) {
+        pushInt(stack, w);
+      }
+    }
+  }
+}
+
+/**
+ * trim method that labels every vertex that trimming can find as a single vertex SCC
+ */
+static void trim(Engine* E) {
+  runParallel(E, countLiveJob);
+  runParallel(E, peelJob);
+}
+
+/*** Phase 2: the giant SCC ***/
+
+/**
+ * expandRange method that adds the live unreached neighbors of frontier[lo .. hi) to thread t's buffer
+ */
+static void expandRange(Engine* E, int t, int lo, int hi) {
+  Snapshot S = E->S;
+  IntBuffer* next = &E->buffers[t];
+  bool forward = E->searchBit == FORWARD;
+  const size_t* offsets = forward ? S->outOffsets : S->inOffsets;
+  const int* targets = forward ? S->outTargets : S->inTargets;
+  for (int i = lo; i < hi; i++) {
+    int x = E->frontier[i];
+    for (size_t e = offsets[x]; e < offsets[x + 1]; e++) {
+      int y = targets[e];
+      if ((LOAD(&E->flags[y]) & E->searchBit) == 0 && isLive(E, y, E->searchColor)
+          && (__atomic_fetch_or(&E->flags[y], E->searchBit, __ATOMIC_RELAXED) & E->searchBit) == 0) {
+        pushInt(next, y); // this thread reached y first
+      }
+    }
+  }
+}
+
+/**
+ * expandJob method that expands thread t's share of the frontier
+ */
+static void expandJob(Engine* E, int t) {
+  E->buffers[t].count = 0;
+  expandRange(E, t, rangeStart(E, E->frontierSize, t), rangeStart(E, E->frontierSize, t + 1));
+}
+
+/**
+ * parallelSearch method that sets bit in the flags of every vertex with color c that the pivot can
+ * reach (FORWARD) or that can reach the pivot (BACKWARD), one level at a time
+ */
+static void parallelSearch(Engine* E, int pivot, int c, unsigned char bit) {
+  E->searchColor = c;
+  E->searchBit = bit;
+  E->flags[pivot] |= bit;
+  E->frontier[0] = pivot;
+  E->frontierSize = 1;
+  while (E->frontierSize > 0) {
+    int used; // the number of buffers holding the next level
+    if (E->frontierSize < PARALLEL_FRONTIER) { // not worth waking the other threads
+      E->buffers[0].count = 0;
+      expandRange(E, 0, 0, E->frontierSize);
+      used = 1;
+    }
+    else {
+      runParallel(E, expandJob);
+      used = E->numThreads;
+    }
+    E->frontierSize = 0;
+    for (int t = 0; t < used; t++) { // the next level becomes the frontier
+      memcpy(E->frontier + E->frontierSize, E->buffers[t].items, sizeof(int) * E->buffers[t].count);
+      E->frontierSize += E->buffers[t].count;
+    }
+  }
+}
+
+/**
+ * splitJob method that labels the vertices in thread t's share that both searches reached, and moves
+ * the others into the FW, BW or remaining subproblem
+ */
+static void splitJob(Engine* E, int t) {
+  int base = E->numColors - 3; // the three colors handed out for this split
+  for (int v = rangeStart(E, E->n, t); v < rangeStart(E, E->n, t + 1); v++) {
+    if (E->comp[v] != UNLABELLED) {
+      continue;
+    }
+    int reached = E->flags[v] & (FORWARD | BACKWARD);
+    E->flags[v] = 0;
+    if (reached == (FORWARD | BACKWARD)) {
+      E->comp[v] = E->numComponents - 1; // the SCC of the pivot was the last id handed out
+    }
+    else {
+      E->color[v] = base + (reached == FORWARD ? 0 : reached == BACKWARD ? 1 : 2);
+    }
+  }
+}
+
+/**
+ * giantSCC method that finds the SCC of the unlabelled vertex with the most incoming times outgoing
+ * live neighbors, which on power-law graphs is almost always the largest SCC
+ *
+ * @return - false if every vertex is already labelled
+ */
+static bool giantSCC(Engine* E) {
+  int pivot = -1;
+  long long best = -1;
+  for (int v = 0; v < E->n; v++) {
+    long long score = (long long) E->liveIn[v] * E->liveOut[v];
+    if (E->comp[v] == UNLABELLED && score > best) {
+      pivot = v;
+      best = score;
+    }
+  }
+  if (pivot < 0) {
+    return false;
+  }
+  parallelSearch(E, pivot, E->color[pivot], FORWARD);
+  parallelSearch(E, pivot, E->color[pivot], BACKWARD);
+  newComponent(E);
+  newColors(E, 3);
+  runParallel(E, splitJob);
+  return true;
+}
+
+/*** Phase 4: work-stealing subproblems ***/
+
+/**
+ * newTask method that returns a Task with room for size vertices
+ */
+static Task* newTask(int color, int size, bool sequential) {
+  Task* task = malloc(sizeof(Task) + sizeof(int) * size);
+  task->color = color;
+  task->size = 0;
+  task->sequential = sequential;
+  return task;
+}
+
+/**
+ * pushTask method that adds task to the newest end of deque t
+ */
+static void pushTask(Engine* E, int t, Task* task) {
+  __atomic_add_fetch(&E->pendingTasks, 1, __ATOMIC_SEQ_CST);
+  Deque* D = &E->deques[t];
+  pthread_mutex_lock(&D->lock);
+  if (D->tail == D->capacity) {
+    if (D->head > 0) { // reuse the room left by stolen tasks
+      memmove(D->tasks, D->tasks + D->head, sizeof(Task*) * (D->tail - D->head));
+      D->tail -= D->head;
+      D->head = 0;
+    }
+    if (D->tail == D->capacity) {
+      D->capacity = D->capacity == 0 ? 64 : D->capacity * 2;
+      D->tasks = realloc(D->tasks, sizeof(Task*) * D->capacity);
+    }
+  }
+  D->tasks[D->tail++] = task;
+  pthread_mutex_unlock(&D->lock);
+}
+
+/**
+ * takeTask method that removes and returns the newest (own deque) or oldest (stealing) task in deque
+ * t, or NULL if it is empty
+ */
+static Task* takeTask(Engine* E, int t, bool steal) {
+  Deque* D = &E->deques[t];
+  Task* task = NULL;
+  pthread_mutex_lock(&D->lock);
+  if (D->head < D->tail) {
+    task = steal ? D->tasks[D->head++] : D->tasks[--D->tail];
+  }
+  pthread_mutex_unlock(&D->lock);
+  return task;
+}
+
+/**
+ * searchTask method that sets bit in the flags of every vertex in the task that the pivot can reach
+ * (FORWARD) or that can reach the pivot (BACKWARD)
+ */
+static void searchTask(Engine* E, int t, Task* task, int pivot, unsigned char bit) {
+  Snapshot S = E->S;
+  const size_t* offsets = bit == FORWARD ? S->outOffsets : S->inOffsets;
+  const int* targets = bit == FORWARD ? S->outTargets : S->inTargets;
+  IntBuffer* stack = &E->buffers[t];
+  stack->count = 0;
+  E->flags[pivot] |= bit;
+  pushInt(stack, pivot);
+  while (stack->count > 0) {
+    int x = stack->items[--stack->count];
+    for (size_t e = offsets[x]; e < offsets[x + 1]; e++) {
+      int y = targets[e];
+      if (isLive(E, y, task->color) && (E->flags[y] & bit) == 0) {
+        E->flags[y] |= bit;
+        pushInt(stack, y);
+      }
+    }
+  }
+}
+
+/**
+ * tarjanTask method that finds every SCC of the task with an iterative version of Tarjan's algorithm
+ */
+static void tarjanTask(Engine* E, Task* task) {
+  Snapshot S = E->S;
+  int c = task->color;
+  int* path = malloc(sizeof(int) * task->size); // the DFS path
+  int* stack = malloc(sizeof(int) * task->size); // the Tarjan stack
+  int pathTop = 0;
+  int stackTop = 0;
+  int index = 0;
+  for (int i = 0; i < task->size; i++) {
+    E->order[task->vertices[i]] = -1;
+  }
+
+  for (int i = 0; i < task->size; i++) {
+    int s = task->vertices[i];
+    if (E->order[s] >= 0) {
+      continue;
+    }
+    E->order[s] = E->low[s] = index++;
+    E->cursors[s] = 0;
+    E->flags[s] |= ON_STACK;
+    stack[stackTop++] = s;
+    path[pathTop++] = s;
+    while (pathTop > 0) {
+      int x = path[pathTop - 1];
+      if (E->cursors[x] < S->outOffsets[x + 1] - S->outOffsets[x]) {
+        int y = S->outTargets[S->outOffsets[x] + E->cursors[x]++];
+        if (!isLive(E, y, c)) { // outside the task, or in an SCC that is already finished
+          continue;
+        }
+        if (E->order[y] < 0) { // extend the DFS path to y
+          E->order[y] = E->low[y] = index++;
+          E->cursors[y] = 0;
+          E->flags[y] |= ON_STACK;
+          stack[stackTop++] = y;
+          path[pathTop++] = y;
+        }
+        else if ((E->flags[y] & ON_STACK) && E->order[y] < E->low[x]) {
+          E->low[x] = E->order[y];
+        }
+        continue;
+      }
+      pathTop--; // x is done
+      if (E->low[x] == E->order[x]) { // x is the root of an SCC: pop it off the Tarjan stack
+        int id = newComponent(E);
+        int y;
+        do {
+          y = stack[--stackTop];
+          E->flags[y] &= ~ON_STACK;
+          STORE(&E->comp[y], id);
+        } while (y != x);
+      }
+      if (pathTop > 0 && E->low[x] < E->low[path[pathTop - 1]]) {
+        E->low[path[pathTop - 1]] = E->low[x];
+      }
+    }
+  }
+  free(path);
+  free(stack);
+}
+
+/**
+ * processTask method that finishes a small task with Tarjan, or splits a large one with FW-BW and
+ * pushes the parts as new tasks
+ */
+static void processTask(Engine* E, int t, Task* task) {
+  if (task->sequential || task->size <= SEQUENTIAL_CUTOFF) {
+    tarjanTask(E, task);
+    return;
+  }
+  int pivot = task->vertices[0];
+  searchTask(E, t, task, pivot, FORWARD);
+  searchTask(E, t, task, pivot, BACKWARD);
+  int id = newComponent(E);
+  int base = newColors(E, 3);
+  int counts[3] = {0, 0, 0};
+  for (int i = 0; i < task->size; i++) { // label the pivot's SCC and recolor the rest
+    int v = task->vertices[i];
+    int reached = E->flags[v] & (FORWARD | BACKWARD);
+    E->flags[v] = 0;
+    if (reached == (FORWARD | BACKWARD)) {
+      STORE(&E->comp[v], id);
+      continue;
+    }
+    int part = reached == FORWARD ? 0 : reached == BACKWARD ? 1 : 2;
+    STORE(&E->color[v], base + part);
+    counts[part]++;
+  }
+
+  Task* parts[3];
+  for (int p = 0; p < 3; p++) {
+    bool poor = counts[p] > task->size - task->size / POOR_SPLIT; // FW-BW barely shrank this part
+    parts[p] = counts[p] == 0 ? NULL : newTask(base + p, counts[p], poor);
+  }
+  for (int i = 0; i < task->size; i++) {
+    int v = task->vertices[i];
+    if (E->comp[v] == UNLABELLED) {
+      Task* part = parts[E->color[v] - base];
+      part->vertices[part->size++] = v;
+    }
+  }
+  for (int p = 0; p < 3; p++) {
+    if (parts[p] != NULL) {
+      pushTask(E, t, parts[p]);
+    }
+  }
+}
+
+/**
+ * workJob method that runs tasks, its own first and then stolen ones, until none are left anywhere
+ */
+static void workJob(Engine* E, int t) {
+  while (true) {
+    Task* task = takeTask(E, t, false);
+    for (int k = 1; task == NULL && k < E->numThreads; k++) { // steal from the other threads in turn
+      task = takeTask(E, (t + k) % E->numThreads, true);
+    }
+    if (task == NULL) {
+      if (__atomic_load_n(&E->pendingTasks, __ATOMIC_SEQ_CST) == 0) {
+        return;
+      }
+      sched_yield(); // a running task may still push more work
+      continue;
+    }
+    processTask(E, t, task);
+    free(task);
+    __atomic_sub_fetch(&E->pendingTasks, 1, __ATOMIC_SEQ_CST);
+  }
+}
+
+/**
+ * solveSubproblems method that makes a task for each color that still has unlabelled vertices and runs
+ * them all in the work-stealing pool
+ */
+static void solveSubproblems(Engine* E) {
+  int* counts = calloc(E->numColors, sizeof(int));
+  for (int v = 0; v < E->n; v++) {
+    if (E->comp[v] == UNLABELLED) {
+      counts[E->color[v]]++;
+    }
+  }
+  Task** tasks = calloc(E->numColors, sizeof(Task*));
+  for (int c = 0; c < E->numColors; c++) {
+    if (counts[c] > 0) {
+      tasks[c] = newTask(c, counts[c], false);
+    }
+  }
+  for (int v = 0; v < E->n; v++) {
+    if (E->comp[v] == UNLABELLED) {
+      Task* task = tasks[E->color[v]];
+      task->vertices[task->size++] = v;
+    }
+  }
+  int next = 0;
+  for (int c = 0; c < E->numColors; c++) { // deal the tasks out round robin
+    if (tasks[c] != NULL) {
+      pushTask(E, next, tasks[c]);
+      next = (next + 1) % E->numThreads;
+    }
+  }
+  free(counts);
+  free(tasks);
+  runParallel(E, workJob);
+}
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newSCCEngine method that returns an engine for digraphs of numVertices vertices, with its per-vertex
+ * arrays allocated and its numThreads - 1 worker threads started and waiting for jobs
+ *
+ * @param - numVertices - the number of vertices of the digraphs it will run on
+ * @param - numThreads - the number of threads to use (at least 1)
+ * @return - the new engine
+ */
+SCCEngine newSCCEngine(int numVertices, int numThreads) {
+  int n = numVertices;
+  Engine* E = calloc(1, sizeof(Engine));
+  E->n = n;
+  E->numThreads = numThreads;
+  E->comp = malloc(sizeof(int) * n);
+  E->color = malloc(sizeof(int) * n);
+  E->liveOut = malloc(sizeof(int) * n);
+  E->liveIn = malloc(sizeof(int) * n);
+  E->flags = malloc(n);
+  E->order = malloc(sizeof(int) * n);
+  E->low = malloc(sizeof(int) * n);
+  E->cursors = malloc(sizeof(size_t) * n);
+  E->frontier = malloc(sizeof(int) * (n + 1));
+  E->renumber = malloc(sizeof(int) * (n + 1));
+  E->buffers = calloc(numThreads, sizeof(IntBuffer));
+  E->deques = calloc(numThreads, sizeof(Deque));
+
+  pthread_mutex_init(&E->lock, NULL);
+  pthread_cond_init(&E->start, NULL);
+  pthread_cond_init(&E->done, NULL);
+  E->threads = malloc(sizeof(pthread_t) * numThreads);
+  E->args = malloc(sizeof(WorkerArg) * numThreads);
+  for (int t = 0; t < numThreads; t++) {
+    pthread_mutex_init(&E->deques[t].lock, NULL);
+    E->args[t].E = E;
+    E->args[t].t = t;
+    if (t > 0) {
+      pthread_create(&E->threads[t], NULL, workerMain, &E->args[t]);
+    }
+  }
+  return E;
+}
+
+/**
+ * freeSCCEngine method that stops and joins the worker threads of *pE, frees all of its memory and sets
+ * *pE to NULL
+ *
+ * @param - pE - the pointer to the engine
+ */
+void freeSCCEngine(SCCEngine* pE) {
+  Engine* E = *pE;
+  pthread_mutex_lock(&E->lock);
+  E->quit = true;
+  pthread_cond_broadcast(&E->start);
+  pthread_mutex_unlock(&E->lock);
+  for (int t = 1; t < E->numThreads; t++) {
+    pthread_join(E->threads[t], NULL);
+  }
+
+  for (int t = 0; t < E->numThreads; t++) {
+    pthread_mutex_destroy(&E->deques[t].lock);
+    free(E->deques[t].tasks);
+    free(E->buffers[t].items);
+  }
+  pthread_mutex_destroy(&E->lock);
+  pthread_cond_destroy(&E->start);
+  pthread_cond_destroy(&E->done);
+  free(E->threads);
+  free(E->args);
+  free(E->deques);
+  free(E->buffers);
+  free(E->renumber);
+  free(E->frontier);
+  free(E->cursors);
+  free(E->low);
+  free(E->order);
+  free(E->flags);
+  free(E->liveIn);
+  free(E->liveOut);
+  free(E->color);
+  free(E->comp);
+  free(E);
+  *pE = NULL;
+}
+
+/*** Parallel SCC ***/
+
+/**
+ * parallelSCC method that finds the SCCs of the digraph frozen in S on the threads of E
+ *
+ * @param - E - the engine, made for S's number of vertices
+ * @param - S - the frozen digraph
+ * @param - componentIds - where the SCC index of each vertex is stored
+ * @return - the number of SCCs
+ */
+int parallelSCC(SCCEngine E, Snapshot S, int* componentIds) {
+  int n = E->n;
+  E->S = S;
+  E->numComponents = 0;
+  E->numColors = 1; // every vertex starts with color 0
+  memset(E->color, 0, sizeof(int) * n);
+  memset(E->flags, 0, n);
+  for (int v = 0; v < n; v++) {
+    E->comp[v] = UNLABELLED;
+  }
+  for (int t = 0; t < E->numThreads; t++) { // every task of the last run was taken
+    E->deques[t].head = E->deques[t].tail = 0;
+  }
+
+  trim(E); // phase 1
+  if (giantSCC(E)) { // phase 2
+    trim(E); // phase 3
+    solveSubproblems(E); // phase 4
+  }
+
+  int* renumber = E->renumber; // number the SCCs by smallest vertex
+  for (int c = 0; c < E->numComponents; c++) {
+    renumber[c] = -1;
+  }
+  int count = 0;
+  for (int v = 0; v < n; v++) {
+    int c = E->comp[v];
+    if (renumber[c] < 0) {
+      renumber[c] = count++;
+    }
+    componentIds[v] = renumber[c];
+  }
+  E->S = NULL; // S may be freed before the next run
+  return count;
+}
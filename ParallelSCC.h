@@ -0,0 +1,33 @@
+/************************************************************
+ * ParallelSCC.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef PARALLELSCC_H
+#define PARALLELSCC_H
+
+#include "Snapshot.h"
+
+// A pool of threads and the per-vertex arrays they share, kept between runs so that finding the SCCs
+// again after the digraph changes doesn't start and join a thread set every time. The worker threads
+// wait on a condition variable between runs.
+
+// private Engine type
+typedef struct Engine* SCCEngine;
+
+// Constructors-Destructors ---------------------------------------------------
+SCCEngine newSCCEngine(int numVertices, int numThreads); // returns an engine for digraphs with
+// numVertices vertices, with its numThreads - 1 worker threads started (the caller is thread 0)
+
+void freeSCCEngine(SCCEngine* pE); // stops and joins the worker threads, frees all heap memory
+// associated with its SCCEngine* argument, and sets *pE to NULL
+
+
+// Manipulation procedures ----------------------------------------------------
+int parallelSCC(SCCEngine E, Snapshot S, int* componentIds);
+// Finds the Strongly Connected Components of the digraph frozen in S on the threads of E, which must
+// have been made for S's number of vertices. Stores the index of each vertex's SCC in componentIds
+// (numVertices entries) and returns the number of SCCs. The SCCs are numbered in the order of their
+// smallest vertex, so the labelling only depends on the digraph and not on how the threads were
+// scheduled. Only one parallelSCC may run on E at a time.
+
+#endif
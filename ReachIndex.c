@@ -0,0 +1,262 @@
+/************************************************************
+ * ReachIndex.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in ReachIndex.h
+ ************************************************************/
+#include <stdlib.h>
+#include <limits.h>
+#include "ReachIndex.h"
+
+/**
+ * ReachIndexObj struct that holds the labels of every SCC, with the REACH_LABELS intervals of SCC c
+ * next to each other at c * REACH_LABELS so one query reads them from a single cache line
+ */
+struct ReachIndexObj {
+  int capacity; // the most SCCs the index has room for
+  int* lows; // the smallest postorder number each SCC can reach, for each label
+  int* posts; // the postorder number of each SCC, for each label
+  int* preorder; // the preorder number of each SCC in each traversal's spanning forest
+  int* subtreeEnds; // one past the last preorder number in each SCC's subtree of that forest
+  int* stack; // the traversal stack
+  int* cursors; // the number of edges each SCC on the stack has looked at
+  int* starts; // the edge each SCC's traversal starts at, so the children come in a rotated order
+  int* order; // the order the traversal starts from the SCCs in
+  int* marks; // the search that last reached each SCC
+  int stamp; // the number of the current search
+};
+
+/**
+ * nextRandom method that returns the next number from a xorshift generator
+ */
+static unsigned nextRandom(unsigned* state) {
+  unsigned x = *state;
+  x ^= x << 13;
+  x ^= x >> 17;
+  x ^= x << 5;
+  *state = x;
+  return x;
+}
+
+/**
+ * nextStamp method that starts a new search, clearing marks when the stamps run out
+ */
+static void nextStamp(ReachIndex R) {
+  if (R->stamp == INT_MAX) {
+    for (int c = 0; c < R->capacity; c++) {
+      R->marks[c] = 0;
+    }
+    R->stamp = 0;
+  }
+  R->stamp++;
+}
+
+/**
+ * contains method that returns whether every label interval of SCC b lies inside that of SCC a, which
+ * has to hold if a reaches b
+ */
+static bool contains(ReachIndex R, int a, int b) {
+  const int* lowA = R->lows + (size_t) a * REACH_LABELS;
+  const int* lowB = R->lows + (size_t) b * REACH_LABELS;
+  const int* postA = R->posts + (size_t) a * REACH_LABELS;
+  const int* postB = R->posts + (size_t) b * REACH_LABELS;
+  for (int j = 0; j < REACH_LABELS; j++) {
+    if (lowB[j] < lowA[j] || postB[j] > postA[j]) {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * inSubtree method that returns whether SCC b is in SCC a's subtree of one of the traversals' spanning
+ * forests, which means a reaches b
+ */
+static bool inSubtree(ReachIndex R, int a, int b) {
+  const int* preA = R->preorder + (size_t) a * REACH_LABELS;
+  const int* preB = R->preorder + (size_t) b * REACH_LABELS;
+  const int* endA = R->subtreeEnds + (size_t) a * REACH_LABELS;
+  for (int j = 0; j < REACH_LABELS; j++) {
+    if (preA[j] <= preB[j] && preB[j] < endA[j]) {
+      return true;
+    }
+  }
+  return false;
+}
+
+/**
+ * traverse method that runs one randomized depth first traversal of C and fills in label j
+ *
+ * @param - R - the ReachIndex
+ * @param - C - the Condensation
+ * @param - j - the label
+ * @param - state - the random state
+ */
+static void traverse(ReachIndex R, Condensation C, int j, unsigned* state) {
+  int n = C->numComponents;
+  for (int i = 0; i < n; i++) { // a random order to start from the SCCs in
+    int k = (int) (nextRandom(state) % (unsigned) (i + 1));
+    R->order[i] = R->order[k];
+    R->order[k] = i;
+  }
+  nextStamp(R);
+  int post = 0;
+  int pre = 0;
+  for (int i = 0; i < n; i++) {
+    int s = R->order[i];
+    if (R->marks[s] == R->stamp) {
+      continue;
+    }
+    int top = 0;
+    R->stack[top++] = s;
+    R->marks[s] = R->stamp;
+    for (;;) {
+      int x = R->stack[top - 1];
+      int degree = (int) (C->offsets[x + 1] - C->offsets[x]);
+      if (R->cursors[x] == 0 && R->starts[x] < 0) { // x was just pushed
+        R->starts[x] = degree > 0 ? (int) (nextRandom(state) % (unsigned) degree) : 0;
+        R->lows[(size_t) x * REACH_LABELS + j] = INT_MAX;
+        R->preorder[(size_t) x * REACH_LABELS + j] = pre++;
+      }
+      if (R->cursors[x] < degree) {
+        int y = C->targets[C->offsets[x] + (R->starts[x] + R->cursors[x]++) % degree];
+        if (R->marks[y] != R->stamp) { // a DAG has no back edges, so a marked y is already finished
+          R->marks[y] = R->stamp;
+          R->cursors[y] = 0;
+          R->starts[y] = -1;
+          R->stack[top++] = y;
+        }
+        else if (R->lows[(size_t) y * REACH_LABELS + j] < R->lows[(size_t) x * REACH_LABELS + j]) {
+          R->lows[(size_t) x * REACH_LABELS + j] = R->lows[(size_t) y * REACH_LABELS + j];
+        }
+        continue;
+      }
+      top--; // x is finished
+      int* low = &R->lows[(size_t) x * REACH_LABELS + j];
+      R->posts[(size_t) x * REACH_LABELS + j] = post;
+      if (post < *low) {
+        *low = post;
+      }
+      post++;
+      R->subtreeEnds[(size_t) x * REACH_LABELS + j] = pre;
+      if (top == 0) {
+        break;
+      }
+      int* parentLow = &R->lows[(size_t) R->stack[top - 1] * REACH_LABELS + j];
+      if (*low < *parentLow) {
+        *parentLow = *low;
+      }
+    }
+  }
+}
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newReachIndex method that returns an empty ReachIndex for condensations with at most capacity SCCs
+ *
+ * @param - capacity - the most SCCs
+ * @return - the new ReachIndex
+ */
+ReachIndex newReachIndex(int capacity) {
+  ReachIndex R = malloc(sizeof(struct ReachIndexObj));
+  R->capacity = capacity;
+  R->lows = malloc(sizeof(int) * ((size_t) capacity * REACH_LABELS + 1));
+  R->posts = malloc(sizeof(int) * ((size_t) capacity * REACH_LABELS + 1));
+  R->preorder = malloc(sizeof(int) * ((size_t) capacity * REACH_LABELS + 1));
+  R->subtreeEnds = malloc(sizeof(int) * ((size_t) capacity * REACH_LABELS + 1));
+  R->stack = malloc(sizeof(int) * (capacity + 1));
+  R->cursors = malloc(sizeof(int) * (capacity + 1));
+  R->starts = malloc(sizeof(int) * (capacity + 1));
+  R->order = malloc(sizeof(int) * (capacity + 1));
+  R->marks = calloc(capacity + 1, sizeof(int));
+  R->stamp = 0;
+  return R;
+}
+
+/**
+ * freeReachIndex method that frees the heap memory used by the ReachIndex
+ *
+ * @param - pR - the pointer to the ReachIndex
+ */
+void freeReachIndex(ReachIndex* pR) {
+  ReachIndex R = *pR;
+  free(R->lows);
+  free(R->posts);
+  free(R->preorder);
+  free(R->subtreeEnds);
+  free(R->stack);
+  free(R->cursors);
+  free(R->starts);
+  free(R->order);
+  free(R->marks);
+  free(R);
+  *pR = NULL;
+}
+
+/*** Access functions ***/
+
+/**
+ * reaches method that returns whether SCC a can reach SCC b. The SCCs are numbered in topological
+ * order, so a can only reach b if a <= b. The labels settle most of the remaining pairs, and the rest
+ * are answered by a depth first search from a that skips every SCC that comes after b or whose labels
+ * show it can't reach b, and stops at the first SCC whose spanning subtree holds b
+ *
+ * @param - R - the ReachIndex
+ * @param - C - the Condensation R was built from
+ * @param - a - the starting SCC
+ * @param - b - the SCC to look for
+ * @return - whether a reaches b
+ */
+bool reaches(ReachIndex R, Condensation C, int a, int b) {
+  if (a == b) {
+    return true;
+  }
+  if (a > b || !contains(R, a, b)) {
+    return false;
+  }
+  if (inSubtree(R, a, b)) {
+    return true;
+  }
+  nextStamp(R);
+  int top = 0;
+  R->stack[top++] = a;
+  R->marks[a] = R->stamp;
+  while (top > 0) {
+    int x = R->stack[--top];
+    for (size_t e = C->offsets[x]; e < C->offsets[x + 1]; e++) {
+      int y = C->targets[e];
+      if (y > b) {
+        break; // the targets are in ascending order, so the rest come after b too
+      }
+      if (y == b || (R->marks[y] != R->stamp && inSubtree(R, y, b))) {
+        return true;
+      }
+      if (R->marks[y] == R->stamp || !contains(R, y, b)) {
+        continue;
+      }
+      R->marks[y] = R->stamp;
+      R->stack[top++] = y;
+    }
+  }
+  return false;
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * buildReachIndex method that labels every SCC of C with REACH_LABELS randomized traversals
+ *
+ * @param - R - the ReachIndex
+ * @param - C - the Condensation
+ * @param - seed - picks the traversal orders
+ */
+void buildReachIndex(ReachIndex R, Condensation C, unsigned seed) {
+  unsigned state = seed == 0 ? 1 : seed; // xorshift would only ever return 0
+  for (int j = 0; j < REACH_LABELS; j++) {
+    for (int c = 0; c < C->numComponents; c++) { // every SCC is waiting to be pushed
+      R->cursors[c] = 0;
+      R->starts[c] = -1;
+    }
+    traverse(R, C, j, &state);
+  }
+}
@@ -0,0 +1,41 @@
+/************************************************************
+ * ReachIndex.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef REACHINDEX_H
+#define REACHINDEX_H
+
+#include <stdbool.h>
+#include "Condensation.h"
+
+#define REACH_LABELS 3 // the number of randomized interval labels each SCC gets
+
+// A GRAIL-style reachability index over the condensation of a digraph. Each of REACH_LABELS
+// randomized depth first traversals of the DAG gives every SCC an interval [low, post], where post is
+// its postorder number and low is the smallest postorder number it can reach. If a reaches b, b's
+// interval lies inside a's in every label, so one label that doesn't contain b's interval proves that
+// a can't reach b. The first traversal's spanning forest also gives every SCC a preorder interval,
+// and b being inside a's subtree of that forest proves that a does reach b. Only the pairs that
+// neither test settles fall back to a depth first search, which both tests prune.
+
+// private ReachIndexObj type
+typedef struct ReachIndexObj* ReachIndex;
+
+// Constructors-Destructors ---------------------------------------------------
+ReachIndex newReachIndex(int capacity); // returns an empty ReachIndex for condensations with at
+// most capacity SCCs
+
+void freeReachIndex(ReachIndex* pR); // frees all heap memory associated with its ReachIndex*
+// argument, and sets *pR to NULL
+
+
+// Access functions -----------------------------------------------------------
+bool reaches(ReachIndex R, Condensation C, int a, int b); // Returns whether SCC a can reach SCC b
+// in C, which must be the Condensation R was last built from.
+
+
+// Manipulation procedures ----------------------------------------------------
+void buildReachIndex(ReachIndex R, Condensation C, unsigned seed); // Labels every SCC of C, in
+// O(REACH_LABELS * (numComponents + numEdges)). The seed picks the random traversal orders.
+
+#endif
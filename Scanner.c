@@ -0,0 +1,74 @@
+/************************************************************
+ * Scanner.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Scanner.h
+ ************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "Scanner.h"
+
+struct ScannerObj {
+  FILE *in;
+  char *buffer; // the current chunk of the input
+  size_t pos; // the next unread byte in buffer
+  size_t end; // the number of bytes in buffer
+  char *line; // the last line returned by scanLine
+  size_t lineCapacity;
+};
+
+Scanner newScanner(FILE *in) {
+  Scanner s = malloc(sizeof(struct ScannerObj));
+  s->in = in;
+  s->buffer = malloc(SCANNER_CHUNK);
+  s->pos = 0;
+  s->end = 0;
+  s->lineCapacity = 1024;
+  s->line = malloc(s->lineCapacity);
+  return s;
+}
+
+void freeScanner(Scanner *pS) {
+  free((*pS)->buffer);
+  free((*pS)->line);
+  free(*pS);
+  *pS = NULL;
+}
+
+// Reads the next chunk of the input into the buffer. Returns 0 at the end of the input.
+static int refill(Scanner S) {
+  S->pos = 0;
+  S->end = fread(S->buffer, 1, SCANNER_CHUNK, S->in);
+  return S->end > 0;
+}
+
+int scanChar(Scanner S) {
+  if (S->pos == S->end && !refill(S))
+    return EOF;
+  return (unsigned char) S->buffer[S->pos++];
+}
+
+char *scanLine(Scanner S, size_t *length) {
+  size_t n = 0;
+  for (;;) {
+    if (S->pos == S->end && !refill(S))
+      break;
+    char *start = S->buffer + S->pos;
+    char *newline = memchr(start, '\n', S->end - S->pos);
+    size_t take = newline != NULL ? (size_t) (newline - start) + 1 : S->end - S->pos;
+    if (n + take + 1 > S->lineCapacity) { // make room for the piece and the NUL
+      while (n + take + 1 > S->lineCapacity)
+        S->lineCapacity *= 2;
+      S->line = realloc(S->line, S->lineCapacity);
+    }
+    memcpy(S->line + n, start, take);
+    n += take;
+    S->pos += take;
+    if (newline != NULL)
+      break;
+  }
+  if (n == 0)
+    return NULL;
+  S->line[n] = '\0';
+  *length = n;
+  return S->line;
+}
@@ -0,0 +1,32 @@
+/************************************************************
+ * Scanner.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef SCANNER_H
+#define SCANNER_H
+
+#include <stdio.h>
+
+#define SCANNER_CHUNK 65536 // the number of bytes read from the file at a time
+
+// private ScannerObj type
+typedef struct ScannerObj *Scanner;
+
+// Constructors-Destructors ---------------------------------------------------
+Scanner newScanner(FILE *in); // returns a Scanner that reads in through a buffer of
+// SCANNER_CHUNK bytes, so input of any size is read incrementally
+
+void freeScanner(Scanner *pS); // frees all heap memory associated with its Scanner* argument,
+// and sets *pS to NULL. Does not close the file.
+
+
+// Access functions -----------------------------------------------------------
+int scanChar(Scanner S); // Returns the next byte of the input as an unsigned char, or EOF
+// once the input is used up.
+
+char *scanLine(Scanner S, size_t *length); // Returns the rest of the current line, including
+// its '\n' (if it has one), as a NUL-terminated string of any length, and stores its length
+// in *length. Returns NULL once the input is used up. The string stays valid until the
+// next call.
+
+#endif
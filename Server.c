@@ -0,0 +1,299 @@
+/************************************************************
+ * Server.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Server.h
+ ************************************************************/
+#define _POSIX_C_SOURCE 200809L // for sockets, poll and sigaction
+#include <errno.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include "Server.h"
+
+/**
+ * Client typedef struct that holds one client and the part of its input that hasn't been handled
+ */
+typedef struct Client {
+  int fd; // where the client's lines are read from
+  FILE* file; // where its answers are written
+  Writer out; // the Writer for file
+  void* state; // what the handler's open returned
+  char* buffer; // the bytes read since the last complete line
+  size_t length; // the number of bytes in buffer
+  size_t capacity; // the number of bytes buffer has room for
+  bool readable; // whether poll said the client had something this time around
+  bool connected; // false once the client has disconnected
+} Client;
+
+static int stopPipe[2] = {-1, -1}; // SIGINT and SIGTERM write a byte here to wake poll up
+
+/**
+ * requestStop method that is the SIGINT and SIGTERM handler while a socket is served
+ */
+static void requestStop(int signal) {
+  (void) signal;
+  int saved = errno;
+  ssize_t written = write(stopPipe[1], "", 1);
+  (void) written;
+  errno = saved;
+}
+
+/**
+ * openClient method that starts serving a client that reads from fd and writes to file
+ */
+static void openClient(Client* C, int fd, FILE* file, const ServerHandler* H) {
+  C->fd = fd;
+  C->file = file;
+  C->out = newWriter(file, 0); // the idle handler decides when answers go out
+  if (H->commit != NULL) { // an answer that leaves before the round is over still follows a commit
+    setBeforeWrite(C->out, H->commit, H->context);
+  }
+  C->state = H->open(H->context, C->out);
+  C->capacity = SERVER_CHUNK + 1;
+  C->buffer = malloc(C->capacity);
+  C->length = 0;
+  C->readable = false;
+  C->connected = true;
+}
+
+/**
+ * closeClient method that stops serving a client, after the handler has written its last answers
+ */
+static void closeClient(Client* C, const ServerHandler* H) {
+  H->close(C->state);
+  freeWriter(&C->out);
+  if (C->file != stdout) {
+    fclose(C->file); // closes the socket too
+  }
+  free(C->buffer);
+}
+
+/**
+ * handleLine method that hands the line in buffer[start .. end) to the handler. The byte after the line
+ * (the first byte of the next one, or spare room) is set to NUL while the handler has it
+ */
+static void handleLine(Client* C, const ServerHandler* H, size_t start, size_t end) {
+  char saved = C->buffer[end];
+  C->buffer[end] = '\0';
+  H->line(C->state, C->buffer + start, end - start);
+  C->buffer[end] = saved;
+}
+
+/**
+ * readClient method that reads what a client has sent and handles every line it completes. Called once poll
+ * (or a blocking read) says the client has something, so it reads at most once. The caller commits and
+ * then calls the handler's idle
+ *
+ * @param - C - the Client
+ * @param - H - the ServerHandler
+ * @return - false once the client has disconnected
+ */
+static bool readClient(Client* C, const ServerHandler* H) {
+  if (C->capacity - C->length < SERVER_CHUNK + 1) { // room for a whole chunk and the NUL after it
+    while (C->capacity - C->length < SERVER_CHUNK + 1) {
+      C->capacity *= 2;
+    }
+    C->buffer = realloc(C->buffer, C->capacity);
+  }
+  ssize_t n = read(C->fd, C->buffer + C->length, SERVER_CHUNK);
+  if (n < 0 && (errno == EINTR || errno == EAGAIN)) {
+    return true;
+  }
+  if (n <= 0) { // the client is done, so a line it didn't end is its last one
+    if (C->length > 0) {
+      handleLine(C, H, 0, C->length);
+      C->length = 0;
+    }
+    return false;
+  }
+
+  size_t end = C->length + (size_t) n;
+  size_t start = 0; // where the next line starts
+  char* newline = memchr(C->buffer + C->length, '\n', (size_t) n); // only the new bytes can end a line
+  while (newline != NULL) {
+    size_t next = (size_t) (newline - C->buffer) + 1;
+    handleLine(C, H, start, next);
+    start = next;
+    newline = memchr(C->buffer + start, '\n', end - start);
+  }
+  memmove(C->buffer, C->buffer + start, end - start); // keep the start of a line that hasn't ended
+  C->length = end - start;
+  return true;
+}
+
+/**
+ * commitLines method that lets the handler commit what the lines read this time around did, before any
+ * answer to them is sent
+ */
+static void commitLines(const ServerHandler* H) {
+  if (H->commit != NULL) {
+    H->commit(H->context);
+  }
+}
+
+/**
+ * listenOn method that returns a socket listening at path, or -1 if one can't be set up
+ */
+static int listenOn(const char* path) {
+  struct sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (strlen(path) >= sizeof(address.sun_path)) {
+    return -1;
+  }
+  strcpy(address.sun_path, path);
+
+  struct stat info;
+  if (lstat(path, &info) == 0 && S_ISSOCK(info.st_mode)) { // left behind by a server that was killed
+    unlink(path);
+  }
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd < 0) {
+    return -1;
+  }
+  if (bind(fd, (struct sockaddr*) &address, sizeof(address)) != 0 || listen(fd, SOMAXCONN) != 0) {
+    close(fd);
+    return -1;
+  }
+  return fd;
+}
+
+/**
+ * serveSocket method that serves every connection to the listening socket until SIGINT or SIGTERM. The
+ * first two entries of fds are the stop pipe and the listening socket, and entry i + 2 is client i
+ */
+static void serveSocket(int listener, const ServerHandler* H) {
+  int capacity = 16;
+  int count = 0;
+  Client* clients = malloc(sizeof(Client) * capacity);
+  struct pollfd* fds = malloc(sizeof(struct pollfd) * (capacity + 2));
+
+  bool stopping = false;
+  while (!stopping) {
+    fds[0].fd = stopPipe[0];
+    fds[0].events = POLLIN;
+    fds[1].fd = listener;
+    fds[1].events = POLLIN;
+    for (int i = 0; i < count; i++) {
+      fds[i + 2].fd = clients[i].fd;
+      fds[i + 2].events = POLLIN;
+    }
+    if (poll(fds, count + 2, -1) < 0) {
+      if (errno == EINTR) {
+        continue;
+      }
+      break;
+    }
+    stopping = fds[0].revents != 0;
+
+    bool anyRead = false;
+    for (int i = 0; i < count; i++) { // read from every client that has something, in the order they connected
+      clients[i].readable = (fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR)) != 0;
+      if (clients[i].readable) {
+        clients[i].connected = readClient(&clients[i], H);
+        anyRead = true;
+      }
+    }
+    if (anyRead) {
+      commitLines(H); // one commit for the lines of every client
+    }
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+      if (clients[i].readable) {
+        H->idle(clients[i].state);
+      }
+      if (!clients[i].connected) {
+        closeClient(&clients[i], H);
+        continue;
+      }
+      clients[kept++] = clients[i];
+    }
+    count = kept;
+
+    if (!stopping && (fds[1].revents & POLLIN)) {
+      int fd = accept(listener, NULL, NULL);
+      FILE* file = fd >= 0 ? fdopen(fd, "w") : NULL;
+      if (file == NULL) {
+        if (fd >= 0) {
+          close(fd);
+        }
+        continue;
+      }
+      if (count == capacity) {
+        capacity *= 2;
+        clients = realloc(clients, sizeof(Client) * capacity);
+        fds = realloc(fds, sizeof(struct pollfd) * (capacity + 2));
+      }
+      openClient(&clients[count++], fd, file, H);
+    }
+  }
+
+  for (int i = 0; i < count; i++) { // the clients still connected get the answers they are owed
+    closeClient(&clients[i], H);
+  }
+  free(clients);
+  free(fds);
+}
+
+/*** Serving ***/
+
+/**
+ * runServer method that serves standard input and output, or every connection to a Unix domain socket
+ *
+ * @param - socketPath - where the socket is made, or NULL for standard input and output
+ * @param - H - the ServerHandler
+ * @return - 0, or -1 if the socket couldn't be set up
+ */
+int runServer(const char* socketPath, const ServerHandler* H) {
+  if (socketPath == NULL) {
+    Client C;
+    openClient(&C, STDIN_FILENO, stdout, H);
+    while (C.connected) {
+      C.connected = readClient(&C, H);
+      commitLines(H);
+      H->idle(C.state);
+    }
+    closeClient(&C, H);
+    return 0;
+  }
+
+  int listener = listenOn(socketPath);
+  if (listener < 0 || pipe(stopPipe) != 0) {
+    if (listener >= 0) {
+      close(listener);
+      unlink(socketPath);
+    }
+    return -1;
+  }
+  struct sigaction stop;
+  struct sigaction ignore;
+  struct sigaction oldInt, oldTerm, oldPipe;
+  memset(&stop, 0, sizeof(stop));
+  stop.sa_handler = requestStop;
+  sigemptyset(&stop.sa_mask);
+  memset(&ignore, 0, sizeof(ignore));
+  ignore.sa_handler = SIG_IGN; // a client that disconnects while being answered is noticed on the next read
+  sigemptyset(&ignore.sa_mask);
+  sigaction(SIGINT, &stop, &oldInt);
+  sigaction(SIGTERM, &stop, &oldTerm);
+  sigaction(SIGPIPE, &ignore, &oldPipe);
+
+  serveSocket(listener, H);
+
+  sigaction(SIGINT, &oldInt, NULL);
+  sigaction(SIGTERM, &oldTerm, NULL);
+  sigaction(SIGPIPE, &oldPipe, NULL);
+  close(stopPipe[0]);
+  close(stopPipe[1]);
+  stopPipe[0] = stopPipe[1] = -1;
+  close(listener);
+  unlink(socketPath);
+  return 0;
+}
@@ -0,0 +1,45 @@
+/************************************************************
+ * Server.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef SERVER_H
+#define SERVER_H
+
+#include <stddef.h>
+#include "Writer.h"
+
+#define SERVER_CHUNK 65536 // the most bytes read from a client at a time
+
+// A long-running loop that hands the lines clients send to a ServerHandler, one line at a time,
+// and gives each client a Writer for its answers. The clients are either standard input and
+// output, or every connection to a Unix domain socket. They are served from one thread with
+// poll, so the handler never runs twice at once and everything it touches is shared by the
+// clients without locking. Once every line that has arrived from the clients with input is
+// handled, the handler's commit function is called once for all of them, and then each of their
+// idle functions so they can write their answers out before the server waits for more input. A
+// client that stops reading its answers holds up the others until it reads or disconnects, since
+// answers are written with blocking writes.
+
+// The functions the server calls for each client
+typedef struct ServerHandler {
+  void* context; // passed to open and commit
+  void* (*open)(void* context, Writer out); // a client connected; returns its state
+  void (*line)(void* client, const char* line, size_t length); // a line arrived, with its '\n'
+  // (the last line before the client disconnects can be missing it), NUL-terminated and only
+  // valid until line returns
+  void (*commit)(void* context); // the lines that arrived have been handled, and no answer to
+  // them has been sent yet (can be NULL). Also called by a client's Writer right before it
+  // writes to the client in the middle of a round (a full buffer, or --flush), so no answer
+  // is ever sent before a commit of everything handled up to it
+  void (*idle)(void* client); // every line that has arrived has been handled and committed
+  void (*close)(void* client); // the client disconnected; its Writer is flushed and freed after
+} ServerHandler;
+
+// Serving -------------------------------------------------------------------
+int runServer(const char* socketPath, const ServerHandler* H); // Serves standard input and
+// output if socketPath is NULL, until standard input ends. Otherwise listens on a Unix domain
+// socket at socketPath (replacing a socket left there by an earlier server) and serves every
+// connection until SIGINT or SIGTERM, then removes the socket. Returns 0, or -1 if the socket
+// couldn't be set up.
+
+#endif
@@ -0,0 +1,99 @@
+/************************************************************
+ * Snapshot.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Snapshot.h
+ ************************************************************/
+#include <stdlib.h>
+#include "Snapshot.h"
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newSnapshot method that returns an empty Snapshot with numVertices vertices
+ *
+ * @param - numVertices - the number of vertices
+ * @return - the new Snapshot
+ */
+Snapshot newSnapshot(int numVertices) {
+  Snapshot S = malloc(sizeof(SnapshotObj));
+  S->numVertices = numVertices;
+  S->numEdges = 0;
+  S->outOffsets = calloc(numVertices + 1, sizeof(size_t));
+  S->inOffsets = calloc(numVertices + 1, sizeof(size_t));
+  S->outTargets = NULL;
+  S->inTargets = NULL;
+  S->edgeCapacity = 0;
+  S->borrowed = 0;
+  return S;
+}
+
+/**
+ * borrowSnapshot method that returns a Snapshot that reads the given CSR arrays in place
+ *
+ * @param - numVertices - the number of vertices
+ * @param - numEdges - the number of edges
+ * @param - outOffsets - numVertices + 1 offsets into outTargets
+ * @param - outTargets - the outgoing neighbors
+ * @param - inOffsets - numVertices + 1 offsets into inTargets
+ * @param - inTargets - the incoming neighbors
+ * @return - the new Snapshot
+ */
+Snapshot borrowSnapshot(int numVertices, size_t numEdges, size_t* outOffsets, int* outTargets,
+    size_t* inOffsets, int* inTargets) {
+  Snapshot S = malloc(sizeof(SnapshotObj));
+  S->numVertices = numVertices;
+  S->numEdges = numEdges;
+  S->outOffsets = outOffsets;
+  S->outTargets = outTargets;
+  S->inOffsets = inOffsets;
+  S->inTargets = inTargets;
+  S->edgeCapacity = numEdges;
+  S->borrowed = 1;
+  return S;
+}
+
+/**
+ * freeSnapshot method that frees the heap memory used by the Snapshot
+ *
+ * @param - pS - the pointer to the Snapshot
+ */
+void freeSnapshot(Snapshot* pS) {
+  Snapshot S = *pS;
+  if (!S->borrowed) {
+    free(S->outOffsets);
+    free(S->inOffsets);
+    free(S->outTargets);
+    free(S->inTargets);
+  }
+  free(S);
+  *pS = NULL;
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * reserveEdges method that makes room for numEdges edges. The arrays are only reallocated when they
+ * need to grow, so refreezing a digraph of about the same size reuses them
+ *
+ * @param - S - the Snapshot
+ * @param - numEdges - the number of edges
+ */
+void reserveEdges(Snapshot S, size_t numEdges) {
+  if (S->borrowed) { // switch to arrays of its own, leaving the borrowed ones alone
+    S->outOffsets = malloc(sizeof(size_t) * (S->numVertices + 1));
+    S->inOffsets = malloc(sizeof(size_t) * (S->numVertices + 1));
+    S->outTargets = NULL;
+    S->inTargets = NULL;
+    S->edgeCapacity = 0;
+    S->borrowed = 0;
+  }
+  if (numEdges > S->edgeCapacity) {
+    size_t capacity = numEdges + numEdges / 8; // leave some room for edges added before the next freeze
+    free(S->outTargets);
+    free(S->inTargets);
+    S->outTargets = malloc(sizeof(int) * capacity);
+    S->inTargets = malloc(sizeof(int) * capacity);
+    S->edgeCapacity = capacity;
+  }
+  S->numEdges = numEdges;
+}
@@ -0,0 +1,46 @@
+/************************************************************
+ * Snapshot.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stddef.h>
+
+// An immutable compressed sparse row (CSR) copy of a digraph, laid out for fast traversal:
+// the outgoing neighbors of vertex v (0-based) are outTargets[outOffsets[v] .. outOffsets[v + 1])
+// and its incoming neighbors are inTargets[inOffsets[v] .. inOffsets[v + 1]], both in ascending
+// order. Every edge list is one contiguous int array, so a traversal streams through memory
+// instead of following a pointer per vertex. The fields are read-only for users of a Snapshot.
+typedef struct SnapshotObj {
+  int numVertices; // the number of vertices
+  size_t numEdges; // the number of edges
+  size_t* outOffsets; // numVertices + 1 entries
+  int* outTargets; // numEdges entries
+  size_t* inOffsets; // numVertices + 1 entries (the CSR transpose)
+  int* inTargets; // numEdges entries
+  size_t edgeCapacity; // the number of entries outTargets and inTargets have room for
+  int borrowed; // 1 if the arrays belong to someone else (such as a memory-mapped file)
+} SnapshotObj;
+
+typedef SnapshotObj* Snapshot;
+
+// Constructors-Destructors ---------------------------------------------------
+Snapshot newSnapshot(int numVertices); // returns an empty Snapshot of a digraph with numVertices
+// vertices and no edges
+
+Snapshot borrowSnapshot(int numVertices, size_t numEdges, size_t* outOffsets, int* outTargets,
+    size_t* inOffsets, int* inTargets); // returns a Snapshot that reads the given arrays in place
+// instead of copying them. They must stay valid until the Snapshot is freed or reserveEdges is
+// called, and they are never written to.
+
+void freeSnapshot(Snapshot* pS); // frees all heap memory associated with its Snapshot* argument,
+// and sets *pS to NULL
+
+
+// Manipulation procedures ----------------------------------------------------
+void reserveEdges(Snapshot S, size_t numEdges); // Makes room for numEdges edges and sets
+// numEdges. The caller then fills in the offsets and targets. A borrowed Snapshot gets arrays of
+// its own first.
+
+#endif
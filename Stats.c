@@ -0,0 +1,77 @@
+/************************************************************
+ * Stats.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Stats.h
+ ************************************************************/
+#define _POSIX_C_SOURCE 200809L // for clock_gettime
+#include <time.h>
+#include "Stats.h"
+
+StatsCounters* statsCounters = NULL;
+
+/*** Access functions ***/
+
+/**
+ * statsNanos method that returns the time of a monotonic clock in nanoseconds
+ */
+long long statsNanos(void) {
+  struct timespec t;
+  clock_gettime(CLOCK_MONOTONIC, &t);
+  return (long long) t.tv_sec * 1000000000LL + t.tv_nsec;
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * recordLatency method that records calls calls that took nanos nanoseconds each
+ *
+ * @param - H - the LatencyHistogram
+ * @param - nanos - the latency of each call
+ * @param - calls - the number of calls
+ */
+void recordLatency(LatencyHistogram* H, long long nanos, long long calls) {
+  int b = 0;
+  while (b < LATENCY_BUCKETS - 1 && (nanos >> (b + 1)) > 0) { // the highest set bit
+    b++;
+  }
+  H->buckets[b] += calls;
+  H->count += calls;
+  H->totalNanos += nanos * calls;
+  if (nanos > H->maxNanos) {
+    H->maxNanos = nanos;
+  }
+}
+
+/*** Other operations ***/
+
+/**
+ * writeHistogramJSON method that writes the LatencyHistogram as a JSON object
+ *
+ * @param - out - the file
+ * @param - H - the LatencyHistogram
+ */
+void writeHistogramJSON(FILE* out, const LatencyHistogram* H) {
+  fprintf(out, "{\"count\": %lld, \"total_ns\": %lld, \"max_ns\": %lld, \"histogram_ns\": [",
+      H->count, H->totalNanos, H->maxNanos);
+  const char* separator = "";
+  for (int b = 0; b < LATENCY_BUCKETS; b++) {
+    if (H->buckets[b] > 0) {
+      fprintf(out, "%s[%lld, %lld]", separator, b == 0 ? 0 : 1LL << b, H->buckets[b]);
+      separator = ", ";
+    }
+  }
+  fprintf(out, "]}");
+}
+
+/**
+ * writeCountersJSON method that writes the StatsCounters as a JSON object
+ *
+ * @param - out - the file
+ * @param - C - the StatsCounters
+ */
+void writeCountersJSON(FILE* out, const StatsCounters* C) {
+  fprintf(out, "{\"scc_recomputations\": %lld, \"scc_edge_updates\": %lld, \"scc_splits\": %lld, "
+      "\"scc_update_drops\": %lld, \"vertices_visited\": %lld, \"edges_scanned\": %lld}",
+      C->sccRecomputations, C->sccEdgeUpdates, C->sccSplits, C->sccUpdateDrops, C->verticesVisited,
+      C->edgesScanned);
+}
@@ -0,0 +1,51 @@
+/************************************************************
+ * Stats.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef STATS_H
+#define STATS_H
+
+#include <stdio.h>
+
+#define LATENCY_BUCKETS 40 // bucket b of a LatencyHistogram counts latencies in [2^b, 2^(b + 1)) ns
+
+// Counters for the internal work done by the Digraph ADT, kept only while statsCounters points at
+// one. Every counting site is a single COUNT_STAT, which is one well predicted branch on a global
+// when counting is off, and none of them are inside a loop over edges.
+typedef struct StatsCounters {
+  long long sccRecomputations; // SCC labellings computed from scratch
+  long long sccEdgeUpdates; // AddEdges and DeleteEdges that updated the cached SCCs in place
+  long long sccSplits; // SCCs that were split apart by a DeleteEdge
+  long long sccUpdateDrops; // AddEdges that ran out of update budget and dropped the cached SCCs
+  long long verticesVisited; // vertices expanded by a search (DFS, BFS or an SCC algorithm)
+  long long edgesScanned; // edges followed by those searches
+} StatsCounters;
+
+// Log-bucketed latencies of one kind of command.
+typedef struct LatencyHistogram {
+  long long count;
+  long long totalNanos;
+  long long maxNanos;
+  long long buckets[LATENCY_BUCKETS];
+} LatencyHistogram;
+
+extern StatsCounters* statsCounters; // NULL (the default) turns counting off
+
+#define COUNT_STAT(field, n) do { if (statsCounters != NULL) statsCounters->field += (n); } while (0)
+
+// Access functions -----------------------------------------------------------
+long long statsNanos(void); // Returns the time of a monotonic clock in nanoseconds.
+
+
+// Manipulation procedures ----------------------------------------------------
+void recordLatency(LatencyHistogram* H, long long nanos, long long calls); // Records calls calls
+// that took nanos nanoseconds each.
+
+
+// Other operations -----------------------------------------------------------
+void writeHistogramJSON(FILE* out, const LatencyHistogram* H); // Writes H as a JSON object with its
+// count, total_ns, max_ns and the non-empty buckets as [lower bound in ns, count] pairs.
+
+void writeCountersJSON(FILE* out, const StatsCounters* C); // Writes C as a JSON object.
+
+#endif
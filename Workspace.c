@@ -0,0 +1,106 @@
+/************************************************************
+ * Workspace.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Workspace.h
+ ************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include <limits.h>
+#include "Workspace.h"
+
+/**
+ * growStamps method that reallocates a stamp array from oldCapacity to capacity entries, with the new
+ * entries cleared
+ */
+static int* growStamps(int* stamps, int oldCapacity, int capacity) {
+  stamps = realloc(stamps, sizeof(int) * capacity);
+  memset(stamps + oldCapacity, 0, sizeof(int) * (capacity - oldCapacity));
+  return stamps;
+}
+
+/*** Constructors-Destructors ***/
+
+/**
+ * newWorkspace method that returns a Workspace with room for no vertices
+ *
+ * @return - the new Workspace
+ */
+Workspace newWorkspace(void) {
+  Workspace W = calloc(1, sizeof(WorkspaceObj)); // every array starts out NULL
+  return W;
+}
+
+/**
+ * freeWorkspace method that frees the heap memory used by the Workspace
+ *
+ * @param - pW - the pointer to the Workspace
+ */
+void freeWorkspace(Workspace* pW) {
+  Workspace W = *pW;
+  free(W->marks);
+  free(W->order);
+  free(W->stack);
+  free(W->cursors);
+  free(W->packedCursors);
+  free(W->vertexStamps);
+  free(W->forwardStamps);
+  free(W->backwardStamps);
+  free(W->componentStack);
+  free(W->forwardSCCs);
+  free(W->backwardSCCs);
+  free(W);
+  *pW = NULL;
+}
+
+/*** Access functions ***/
+
+/**
+ * workspaceBytes method that returns the heap memory W uses
+ */
+size_t workspaceBytes(Workspace W) {
+  size_t perVertex = 10 * sizeof(int) + sizeof(size_t) + sizeof(PackedCursor);
+  return sizeof(WorkspaceObj) + perVertex * (size_t) W->capacity;
+}
+
+/*** Manipulation procedures ***/
+
+/**
+ * reserveWorkspace method that makes room for numVertices vertices
+ *
+ * @param - W - the Workspace
+ * @param - numVertices - the number of vertices
+ */
+void reserveWorkspace(Workspace W, int numVertices) {
+  if (numVertices <= W->capacity) {
+    return;
+  }
+  int capacity = numVertices;
+  W->marks = realloc(W->marks, sizeof(int) * capacity);
+  W->order = realloc(W->order, sizeof(int) * capacity);
+  W->stack = realloc(W->stack, sizeof(int) * capacity);
+  W->cursors = realloc(W->cursors, sizeof(size_t) * capacity);
+  W->packedCursors = realloc(W->packedCursors, sizeof(PackedCursor) * capacity);
+  W->vertexStamps = growStamps(W->vertexStamps, W->capacity, capacity);
+  W->forwardStamps = growStamps(W->forwardStamps, W->capacity, capacity);
+  W->backwardStamps = growStamps(W->backwardStamps, W->capacity, capacity);
+  W->componentStack = realloc(W->componentStack, sizeof(int) * capacity);
+  W->forwardSCCs = realloc(W->forwardSCCs, sizeof(int) * capacity);
+  W->backwardSCCs = realloc(W->backwardSCCs, sizeof(int) * capacity);
+  W->capacity = capacity;
+}
+
+/**
+ * nextStamp method that starts a new search
+ *
+ * @param - W - the Workspace
+ * @return - the stamp of the new search
+ */
+int nextStamp(Workspace W) {
+  if (W->stamp == INT_MAX) { // start the stamps over rather than let them wrap around
+    memset(W->vertexStamps, 0, sizeof(int) * W->capacity);
+    memset(W->forwardStamps, 0, sizeof(int) * W->capacity);
+    memset(W->backwardStamps, 0, sizeof(int) * W->capacity);
+    W->stamp = 0;
+  }
+  return ++W->stamp;
+}
@@ -0,0 +1,54 @@
+/************************************************************
+ * Workspace.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef WORKSPACE_H
+#define WORKSPACE_H
+
+#include <stddef.h>
+#include "Packed.h"
+
+// The scratch arrays the searches of a Digraph use, sized to that digraph. They only hold anything
+// while a search runs, so a Digraph makes its Workspace on its first search and keeps it for the
+// next ones, and a digraph that has never been searched keeps no per-vertex scratch. Nothing is
+// shared between Digraphs, so different Digraphs can be used from different threads. The stamp arrays
+// mark what the search numbered stamp has reached; an entry that holds any other number hasn't
+// been reached yet, so starting a new search costs O(1). The fields are read and written directly
+// by the searches.
+typedef struct WorkspaceObj {
+  int capacity; // the number of vertices every array has room for
+  int* marks; // a mark (UNVISITED, INPROGRESS, ...) or a discovery index for each vertex
+  int* order; // the vertices in the order a DFS finished them, or a number for each SCC
+  int* stack; // a DFS stack of vertices
+  size_t* cursors; // the position of the next neighbor of each vertex on a DFS path, in a Snapshot
+  PackedCursor* packedCursors; // the same for a packed digraph
+  int* vertexStamps; // the search that last reached each vertex
+  int* forwardStamps; // the search that last reached each SCC going forward
+  int* backwardStamps; // the search that last reached each SCC going backward
+  int* componentStack; // the SCCs waiting to be expanded by a search
+  int* forwardSCCs; // the SCCs the last forward search reached
+  int* backwardSCCs; // the SCCs the last backward search reached
+  int stamp; // the number of the current search
+} WorkspaceObj;
+
+typedef WorkspaceObj* Workspace;
+
+// Constructors-Destructors ---------------------------------------------------
+Workspace newWorkspace(void); // returns a Workspace with room for no vertices
+
+void freeWorkspace(Workspace* pW); // frees all heap memory associated with its Workspace*
+// argument, and sets *pW to NULL
+
+
+// Access functions -----------------------------------------------------------
+size_t workspaceBytes(Workspace W); // Returns the heap memory W uses.
+
+
+// Manipulation procedures ----------------------------------------------------
+void reserveWorkspace(Workspace W, int numVertices); // Makes room for numVertices vertices. The
+// arrays only grow, and the stamps of the new entries are 0, which no search uses.
+
+int nextStamp(Workspace W); // Starts a new search and returns its stamp. Once the stamps run out,
+// every stamp array is cleared and they start over.
+
+#endif
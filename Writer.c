@@ -0,0 +1,115 @@
+/************************************************************
+ * Writer.c
+ * Tyler Hoang
+ * Contains the code for the functions and descriptions in Writer.h
+ ************************************************************/
+#include <stdlib.h>
+#include <string.h>
+#include "Writer.h"
+
+struct WriterObj {
+  FILE *out;
+  char *buffer;
+  size_t used; // the number of bytes in buffer
+  int flushEachCommand;
+  void (*beforeWrite)(void *context); // called before anything is written to out (can be NULL)
+  void *context;
+};
+
+// "00", "01", ..., "99", so writeInt can convert two digits at a time
+static const char DIGIT_PAIRS[201] =
+  "00010203040506070809101112131415161718192021222324252627282930313233343536373839"
+  "40414243444546474849505152535455565758596061626364656667686970717273747576777879"
+  "8081828384858687888990919293949596979899";
+
+Writer newWriter(FILE *out, int flushEachCommand) {
+  Writer w = malloc(sizeof(struct WriterObj));
+  w->out = out;
+  w->buffer = malloc(WRITER_BUFFER);
+  w->used = 0;
+  w->flushEachCommand = flushEachCommand;
+  w->beforeWrite = NULL;
+  w->context = NULL;
+  return w;
+}
+
+void freeWriter(Writer *pW) {
+  flushWriter(*pW);
+  free((*pW)->buffer);
+  free(*pW);
+  *pW = NULL;
+}
+
+// Lets the beforeWrite hook run before output reaches the file.
+static void beforeWrite(Writer W) {
+  if (W->beforeWrite != NULL)
+    W->beforeWrite(W->context);
+}
+
+// Writes the buffer to the file without flushing the file itself.
+static void drain(Writer W) {
+  if (W->used > 0) {
+    beforeWrite(W);
+    fwrite(W->buffer, 1, W->used, W->out);
+  }
+  W->used = 0;
+}
+
+void writeChars(Writer W, const char *s, size_t n) {
+  if (W->used + n > WRITER_BUFFER) {
+    drain(W);
+    if (n > WRITER_BUFFER) { // too big to buffer, so write it straight through
+      beforeWrite(W);
+      fwrite(s, 1, n, W->out);
+      return;
+    }
+  }
+  memcpy(W->buffer + W->used, s, n);
+  W->used += n;
+}
+
+void writeString(Writer W, const char *s) {
+  writeChars(W, s, strlen(s));
+}
+
+void writeChar(Writer W, char c) {
+  if (W->used == WRITER_BUFFER)
+    drain(W);
+  W->buffer[W->used++] = c;
+}
+
+void writeInt(Writer W, long long x) {
+  char digits[24];
+  char *p = digits + sizeof(digits); // the digits are filled in from the end
+  unsigned long long n = x < 0 ? 0ULL - (unsigned long long) x : (unsigned long long) x;
+  while (n >= 100) {
+    unsigned r = (unsigned) (n % 100);
+    n /= 100;
+    p -= 2;
+    memcpy(p, DIGIT_PAIRS + 2 * r, 2);
+  }
+  if (n >= 10) {
+    p -= 2;
+    memcpy(p, DIGIT_PAIRS + 2 * n, 2);
+  } else {
+    *--p = (char) ('0' + n);
+  }
+  if (x < 0)
+    *--p = '-';
+  writeChars(W, p, digits + sizeof(digits) - p);
+}
+
+void endCommand(Writer W) {
+  if (W->flushEachCommand)
+    flushWriter(W);
+}
+
+void flushWriter(Writer W) {
+  drain(W);
+  fflush(W->out);
+}
+
+void setBeforeWrite(Writer W, void (*beforeWrite)(void *context), void *context) {
+  W->beforeWrite = beforeWrite;
+  W->context = context;
+}
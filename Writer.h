@@ -0,0 +1,43 @@
+/************************************************************
+ * Writer.h
+ * Tyler Hoang
+ ************************************************************/
+#ifndef WRITER_H
+#define WRITER_H
+
+#include <stdio.h>
+
+#define WRITER_BUFFER (1 << 20) // the number of bytes collected before they are written to the file
+
+// private WriterObj type
+typedef struct WriterObj *Writer;
+
+// Constructors-Destructors ---------------------------------------------------
+Writer newWriter(FILE *out, int flushEachCommand); // returns a Writer that collects output
+// for out in a WRITER_BUFFER byte buffer. If flushEachCommand is not 0, endCommand flushes
+// the buffer (for interactive use).
+
+void freeWriter(Writer *pW); // flushes the Writer, frees all heap memory associated with
+// its Writer* argument, and sets *pW to NULL. Does not close the file.
+
+
+// Manipulation procedures ----------------------------------------------------
+void writeChars(Writer W, const char *s, size_t n); // Writes the n bytes at s.
+
+void writeString(Writer W, const char *s); // Writes the NUL-terminated string s.
+
+void writeChar(Writer W, char c); // Writes the byte c.
+
+void writeInt(Writer W, long long x); // Writes x in decimal, without going through printf.
+
+void endCommand(Writer W); // Marks the end of the output for one command. Flushes the
+// buffer if the Writer was created with flushEachCommand.
+
+void flushWriter(Writer W); // Writes everything in the buffer to the file and flushes it.
+
+void setBeforeWrite(Writer W, void (*beforeWrite)(void *context), void *context); // Makes W call
+// beforeWrite(context) every time, right before it writes anything to the file (a full buffer,
+// a flush, or a string too big to buffer), so the caller can make what the output reports
+// durable before it leaves the process.
+
+#endif